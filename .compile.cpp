@@ -4,9 +4,19 @@
  *
  */
 
+#include "include/atomic-auto-ptr.hpp"
 #include "include/auto-ptr.hpp"
+#include "include/bounded-queue.hpp"
+#include "include/event-loop.hpp"
+#include "include/executor.hpp"
+#include "include/inline-function.hpp"
+#include "include/pooling.hpp"
+#include "include/reclaiming.hpp"
 #include "include/ref-counting.hpp"
 #include "include/signaling.hpp"
+#include "include/small-vector.hpp"
+#include "include/thread-pool.hpp"
+#include "include/weak-ptr.hpp"
 
 
 
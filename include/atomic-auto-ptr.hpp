@@ -0,0 +1,197 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Kevin XU <kevin.xu.1982.02.06@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *
+ *
+ * Author: Kevin XU <kevin.xu.1982.02.06@gmail.com>
+ *
+ */
+
+#ifndef __ATOMIC_AUTO_PTR_HPP
+# define __ATOMIC_AUTO_PTR_HPP
+
+# include <cassert>
+# include <cstddef>
+# include <cstdint>
+
+# include <atomic>
+# include <type_traits>
+# include <utility>
+
+# include "auto-ptr.hpp"
+# include "ref-counting.hpp"
+
+
+
+template <class RC>
+class AtomicAutoPtr {
+  static_assert(RefCounting::CHECK<RC>::value, "");
+
+  static_assert(
+      std::is_base_of<AtomicRefCounting, RC>::value
+      || std::is_base_of<BiasedRefCounting, RC>::value,
+      "");
+
+  static_assert(sizeof(RC *) == sizeof(std::uint64_t), "");
+public:
+  typedef RC ContentType;
+
+  constexpr AtomicAutoPtr(void) noexcept: _word(0U) {}
+
+  constexpr AtomicAutoPtr(std::nullptr_t) noexcept: _word(0U) {}
+
+  AtomicAutoPtr(AutoPtr<RC> autoPtr) noexcept: _word(release(autoPtr)) {}
+
+  ~AtomicAutoPtr()
+  {
+    std::uint64_t word = _word.load(std::memory_order_acquire);
+
+    assert((word & ~_MASK) == 0U);
+
+    RC *pointer = unpack(word);
+
+    if (pointer != nullptr)
+      pointer->deref();
+  }
+
+  AtomicAutoPtr &operator=(AutoPtr<RC> autoPtr)
+  {
+    store(std::move(autoPtr));
+
+    return *this;
+  }
+
+  operator AutoPtr<RC> () const noexcept
+  {
+    return load();
+  }
+
+  AutoPtr<RC> load(void) const noexcept
+  {
+    std::uint64_t word = _word.fetch_add(_UNIT, std::memory_order_acquire) + _UNIT;
+
+    RC *pointer = unpack(word);
+
+    if (pointer != nullptr)
+      pointer->ref();
+
+    do
+      if (unpack(word) != pointer || (word & ~_MASK) == 0U) {
+        if (pointer != nullptr)
+          pointer->deref();
+
+        break;
+      }
+    while (!_word.compare_exchange_weak(word, word - _UNIT, std::memory_order_relaxed));
+
+    return AutoPtr<RC>(pointer, typename AutoPtr<RC>::_Adopting());
+  }
+
+  RC *peek(void) const noexcept
+  {
+    return unpack(_word.load(std::memory_order_acquire));
+  }
+
+  void store(AutoPtr<RC> autoPtr)
+  {
+    exchange(std::move(autoPtr));
+  }
+
+  AutoPtr<RC> exchange(AutoPtr<RC> autoPtr) noexcept
+  {
+    std::uint64_t word = _word.exchange(release(autoPtr), std::memory_order_acq_rel);
+
+    RC *pointer = unpack(word);
+
+    lend(pointer, word);
+
+    return AutoPtr<RC>(pointer, typename AutoPtr<RC>::_Adopting());
+  }
+
+  bool compareExchange(AutoPtr<RC> &expected, AutoPtr<RC> desired)
+  {
+    std::uint64_t word = _word.load(std::memory_order_relaxed);
+
+    while (unpack(word) == expected._pointer)
+      if (_word.compare_exchange_weak(
+            word,
+            pack(desired._pointer),
+            std::memory_order_acq_rel,
+            std::memory_order_relaxed)) {
+        desired._pointer = nullptr;
+
+        lend(expected._pointer, word);
+
+        if (expected._pointer != nullptr)
+          expected._pointer->deref();
+
+        return true;
+      }
+
+    expected = load();
+
+    return false;
+  }
+
+private:
+  static std::uint64_t constexpr _UNIT = 1ULL << 48U;
+
+  static std::uint64_t constexpr _MASK = _UNIT - 1U;
+
+  mutable std::atomic<std::uint64_t> _word;
+
+  static std::uint64_t pack(RC *pointer) noexcept
+  {
+    std::uint64_t word = reinterpret_cast<std::uintptr_t>(pointer);
+
+    assert((word & ~_MASK) == 0U);
+
+    return word;
+  }
+
+  static RC *unpack(std::uint64_t word) noexcept
+  {
+    return reinterpret_cast<RC *>(static_cast<std::uintptr_t>(word & _MASK));
+  }
+
+  static std::uint64_t release(AutoPtr<RC> &autoPtr) noexcept
+  {
+    std::uint64_t word = pack(autoPtr._pointer);
+
+    autoPtr._pointer = nullptr;
+
+    return word;
+  }
+
+  static void lend(RC *pointer, std::uint64_t word) noexcept
+  {
+    if (pointer == nullptr)
+      return;
+
+    for (std::uint64_t n = word >> 48U; n > 0U; --n)
+      pointer->ref();
+  }
+
+  AtomicAutoPtr(AtomicAutoPtr const &atomicAutoPtr) = delete;
+
+  AtomicAutoPtr &operator=(AtomicAutoPtr const &atomicAutoPtr) = delete;
+};
+
+#endif
@@ -30,7 +30,9 @@
 # include <cassert>
 # include <cstddef>
 
+# include <memory>
 # include <type_traits>
+# include <utility>
 
 # include "ref-counting.hpp"
 
@@ -225,8 +227,12 @@ public:
   }
 
 private:
+  struct _Adopting {};
+
   RC *_pointer;
 
+  constexpr AutoPtr(RC *pointer, _Adopting) noexcept: _pointer(pointer) {}
+
   void set(RC *pointer) noexcept
   {
     if (pointer != nullptr)
@@ -271,6 +277,15 @@ private:
   template <class RC_>
   friend class AutoPtr;
 
+  template <class RC_>
+  friend class AtomicAutoPtr;
+
+  template <class RC_, class ... As>
+  friend AutoPtr<RC_> NEW(As &&... arguments);
+
+  template <class RC_, class A, class ... As>
+  friend AutoPtr<RC_> ALLOCATE(A const &allocator, As &&... arguments);
+
   template <class L, class R>
   friend bool operator==(AutoPtr<L> const &lhs, AutoPtr<R> const &rhs) noexcept;
 
@@ -317,16 +332,55 @@ inline T *operator-(AutoPtr<T> const &autoPtr, int offset) noexcept
   return autoPtr._pointer - offset;
 }
 
+template <class RC, class A>
+class _Allocated final: public RC {
+public:
+  template <class ... As>
+  _Allocated(As &&... arguments): RC(std::forward<As>(arguments)...) {}
+
+  static void *operator new(std::size_t size)
+  {
+    assert(size == sizeof(_Allocated));
+
+    Allocator allocator;
+
+    return std::allocator_traits<Allocator>::allocate(allocator, 1UL);
+  }
+
+  static void operator delete(void *pointer) noexcept
+  {
+    Allocator allocator;
+
+    _Allocated *allocated = static_cast<_Allocated *>(pointer);
+
+    std::allocator_traits<Allocator>::deallocate(allocator, allocated, 1UL);
+  }
+
+protected:
+  ~_Allocated() = default;
+
+private:
+  typedef typename std::allocator_traits<A>::template rebind_alloc<_Allocated> Allocator;
+};
+
 template <class RC, class ... As>
-inline AutoPtr<RC> NEW(As... arguments)
+inline AutoPtr<RC> NEW(As &&... arguments)
+{
+  return AutoPtr<RC>(new RC(std::forward<As>(arguments)...), typename AutoPtr<RC>::_Adopting());
+}
+
+template <class RC, class A, class ... As>
+inline AutoPtr<RC> ALLOCATE(A const &allocator, As &&... arguments)
 {
-  RC *refCounting = new RC(arguments...);
+  static_assert(std::has_virtual_destructor<RC>::value, "");
+
+  static_assert(!std::is_final<RC>::value, "");
 
-  AutoPtr<RC> _refCounting = refCounting;
+  static_assert(std::allocator_traits<A>::is_always_equal::value, "");
 
-  refCounting->deref();
+  RC *refCounting = new _Allocated<RC, A>(std::forward<As>(arguments)...);
 
-  return _refCounting;
+  return AutoPtr<RC>(refCounting, typename AutoPtr<RC>::_Adopting());
 }
 
 #endif
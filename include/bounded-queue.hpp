@@ -0,0 +1,163 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Kevin XU <kevin.xu.1982.02.06@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *
+ *
+ * Author: Kevin XU <kevin.xu.1982.02.06@gmail.com>
+ *
+ */
+
+#ifndef __BOUNDED_QUEUE_HPP
+# define __BOUNDED_QUEUE_HPP
+
+# include <cstddef>
+
+# include <atomic>
+# include <new>
+# include <stdexcept>
+# include <type_traits>
+# include <utility>
+
+
+
+template <class T>
+class BoundedQueue {
+  static_assert(std::is_nothrow_move_constructible<T>::value, "");
+public:
+  BoundedQueue(std::size_t capacity):
+    _mask(capacity - 1UL),
+    _cells(nullptr),
+    _tail(0UL),
+    _head(0UL)
+  {
+    if (capacity < 2UL || (capacity & _mask) != 0UL)
+      throw std::runtime_error("");
+
+    _cells = new _Cell[capacity];
+
+    for (std::size_t i = 0UL; i < capacity; ++i)
+      _cells[i].sequence.store(i, std::memory_order_relaxed);
+  }
+
+  ~BoundedQueue()
+  {
+    T value;
+
+    while (tryPop(value));
+
+    delete [] _cells;
+  }
+
+  std::size_t capacity(void) const noexcept
+  {
+    return _mask + 1UL;
+  }
+
+  template <class U>
+  bool tryPush(U &&value)
+  {
+    if constexpr (std::is_nothrow_constructible<T, U &&>::value)
+      return push(std::forward<U>(value));
+    else
+      return push(T(std::forward<U>(value)));
+  }
+
+  bool tryPop(T &value)
+  {
+    std::size_t head = _head.load(std::memory_order_relaxed);
+
+    _Cell *cell;
+
+    for (;;) {
+      cell = &_cells[head & _mask];
+
+      std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+
+      if (sequence == head + 1UL) {
+        if (_head.compare_exchange_weak(head, head + 1UL, std::memory_order_relaxed))
+          break;
+      } else if (sequence < head + 1UL)
+        return false;
+      else
+        head = _head.load(std::memory_order_relaxed);
+    }
+
+    T *pointer = reinterpret_cast<T *>(cell->storage);
+
+    value = std::move(*pointer);
+
+    pointer->~T();
+
+    cell->sequence.store(head + _mask + 1UL, std::memory_order_release);
+
+    return true;
+  }
+
+private:
+  static std::size_t constexpr _CACHE_LINE_SIZE = 64UL;
+
+  struct _Cell {
+    std::atomic<std::size_t> sequence;
+
+    alignas(T) unsigned char storage[sizeof(T)];
+  };
+
+  std::size_t const _mask;
+
+  _Cell *_cells;
+
+  alignas(_CACHE_LINE_SIZE) std::atomic<std::size_t> _tail;
+
+  alignas(_CACHE_LINE_SIZE) std::atomic<std::size_t> _head;
+
+  BoundedQueue(BoundedQueue const &boundedQueue) = delete;
+
+  BoundedQueue &operator=(BoundedQueue const &boundedQueue) = delete;
+
+  template <class U>
+  bool push(U &&value) noexcept
+  {
+    std::size_t tail = _tail.load(std::memory_order_relaxed);
+
+    _Cell *cell;
+
+    for (;;) {
+      cell = &_cells[tail & _mask];
+
+      std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+
+      if (sequence == tail) {
+        if (_tail.compare_exchange_weak(tail, tail + 1UL, std::memory_order_relaxed))
+          break;
+      } else if (sequence < tail)
+        return false;
+      else
+        tail = _tail.load(std::memory_order_relaxed);
+    }
+
+    new (cell->storage) T(std::forward<U>(value));
+
+    cell->sequence.store(tail + 1UL, std::memory_order_release);
+
+    return true;
+  }
+};
+
+#endif
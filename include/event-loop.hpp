@@ -0,0 +1,304 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Kevin XU <kevin.xu.1982.02.06@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *
+ *
+ * Author: Kevin XU <kevin.xu.1982.02.06@gmail.com>
+ *
+ */
+
+#ifndef __EVENT_LOOP_HPP
+# define __EVENT_LOOP_HPP
+
+# include <cerrno>
+# include <cstddef>
+# include <cstdint>
+
+# include <algorithm>
+# include <atomic>
+# include <chrono>
+# include <functional>
+# include <memory>
+# include <stdexcept>
+# include <utility>
+# include <vector>
+
+# include <poll.h>
+# include <sys/eventfd.h>
+# include <unistd.h>
+
+# include "executor.hpp"
+
+
+
+class EventLoop final: public Executor {
+public:
+  EventLoop(void):
+    _inbox(nullptr),
+    _pending(nullptr),
+    _sequence(0UL),
+    _stopping(false),
+    _fd(eventfd(0U, EFD_CLOEXEC))
+  {
+    if (_fd < 0)
+      throw std::runtime_error("");
+  }
+
+  ~EventLoop()
+  {
+    drop(_pending);
+
+    drop(_inbox.load(std::memory_order_acquire));
+
+    close(_fd);
+  }
+
+  static EventLoop *current(void) noexcept
+  {
+    return _current;
+  }
+
+  void post(Task task) override
+  {
+    push(new _Node{std::move(task), Clock::time_point(), nullptr});
+  }
+
+  void post(Task task, Clock::time_point time) override
+  {
+    if (time <= Clock::now())
+      post(std::move(task));
+    else
+      push(new _Node{std::move(task), time, nullptr});
+  }
+
+  std::size_t runOnce(void)
+  {
+    for (;;) {
+      std::size_t n = runPending();
+
+      n += runTimers();
+
+      if (n != 0UL || _stopping.load(std::memory_order_acquire))
+        return n;
+
+      wait();
+    }
+  }
+
+  void run(void)
+  {
+    while (!_stopping.load(std::memory_order_acquire))
+      runOnce();
+
+    _stopping.store(false, std::memory_order_relaxed);
+  }
+
+  void stop(void) noexcept
+  {
+    _stopping.store(true, std::memory_order_release);
+
+    wake();
+  }
+
+private:
+  struct _Node {
+    Task task;
+
+    Clock::time_point time;
+
+    _Node *next;
+  };
+
+  struct _Timer {
+    Clock::time_point time;
+
+    std::size_t sequence;
+
+    Task task;
+
+    friend bool operator>(_Timer const &lhs, _Timer const &rhs) noexcept
+    {
+      return lhs.time > rhs.time || (lhs.time == rhs.time && lhs.sequence > rhs.sequence);
+    }
+  };
+
+  static inline thread_local EventLoop *_current = nullptr;
+
+  std::atomic<_Node *> _inbox;
+
+  _Node *_pending;
+
+  std::vector<_Timer> _timers;
+
+  std::size_t _sequence;
+
+  std::atomic<bool> _stopping;
+
+  int const _fd;
+
+  EventLoop(EventLoop const &eventLoop) = delete;
+
+  EventLoop &operator=(EventLoop const &eventLoop) = delete;
+
+  void push(_Node *node) noexcept
+  {
+    _Node *head = _inbox.load(std::memory_order_relaxed);
+
+    do
+      node->next = head;
+    while (!_inbox.compare_exchange_weak(
+          head,
+          node,
+          std::memory_order_release,
+          std::memory_order_relaxed));
+
+    if (head == nullptr)
+      wake();
+  }
+
+  std::size_t runPending(void)
+  {
+    if (_pending == nullptr) {
+      _Node *node = _inbox.exchange(nullptr, std::memory_order_acquire);
+
+      while (node != nullptr) {
+        _Node *next = node->next;
+
+        node->next = _pending, _pending = node;
+
+        node = next;
+      }
+    }
+
+    EventLoop *previous = _current;
+
+    _current = this;
+
+    std::size_t n = 0UL;
+
+    while (_pending != nullptr) {
+      std::unique_ptr<_Node> node(_pending);
+
+      _pending = node->next;
+
+      if (node->time != Clock::time_point()) {
+        _timers.emplace_back(_Timer{node->time, _sequence++, std::move(node->task)});
+
+        std::push_heap(_timers.begin(), _timers.end(), std::greater<_Timer>());
+
+        continue;
+      }
+
+      try {
+        node->task();
+      } catch (...) {
+        _current = previous;
+
+        throw;
+      }
+
+      ++n;
+    }
+
+    _current = previous;
+
+    return n;
+  }
+
+  std::size_t runTimers(void)
+  {
+    Clock::time_point now = Clock::now();
+
+    EventLoop *previous = _current;
+
+    _current = this;
+
+    std::size_t n = 0UL;
+
+    while (!_timers.empty() && _timers.front().time <= now) {
+      std::pop_heap(_timers.begin(), _timers.end(), std::greater<_Timer>());
+
+      Task task = std::move(_timers.back().task);
+
+      _timers.pop_back();
+
+      try {
+        task();
+      } catch (...) {
+        _current = previous;
+
+        throw;
+      }
+
+      ++n;
+    }
+
+    _current = previous;
+
+    return n;
+  }
+
+  static void drop(_Node *node) noexcept
+  {
+    while (node != nullptr) {
+      _Node *next = node->next;
+
+      delete node;
+
+      node = next;
+    }
+  }
+
+  void wake(void) noexcept
+  {
+    std::uint64_t value = 1U;
+
+    while (write(_fd, &value, sizeof(value)) < 0 && errno == EINTR);
+  }
+
+  void wait(void)
+  {
+    if (!_timers.empty()) {
+      auto timeout = std::chrono::ceil<std::chrono::milliseconds>(
+          _timers.front().time - Clock::now()).count();
+
+      if (timeout <= 0)
+        return;
+
+      pollfd fd = {_fd, POLLIN, 0};
+
+      int result = poll(&fd, 1, timeout > 1000000 ? 1000000 : static_cast<int>(timeout));
+
+      if (result < 0 && errno != EINTR)
+        throw std::runtime_error("");
+
+      if (result <= 0)
+        return;
+    }
+
+    std::uint64_t value;
+
+    while (read(_fd, &value, sizeof(value)) < 0)
+      if (errno != EINTR)
+        throw std::runtime_error("");
+  }
+};
+
+#endif
@@ -0,0 +1,57 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Kevin XU <kevin.xu.1982.02.06@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *
+ *
+ * Author: Kevin XU <kevin.xu.1982.02.06@gmail.com>
+ *
+ */
+
+#ifndef __EXECUTOR_HPP
+# define __EXECUTOR_HPP
+
+# include <chrono>
+
+# include "inline-function.hpp"
+
+
+
+class Executor {
+public:
+  typedef InlineFunction<void (void), 48UL> Task;
+
+  typedef std::chrono::steady_clock Clock;
+
+  virtual void post(Task task) = 0;
+
+  virtual void post(Task task, Clock::time_point time) = 0;
+
+protected:
+  Executor(void) = default;
+
+  ~Executor() = default;
+
+private:
+  Executor(Executor const &executor) = delete;
+
+  Executor &operator=(Executor const &executor) = delete;
+};
+
+#endif
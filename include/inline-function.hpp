@@ -0,0 +1,221 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Kevin XU <kevin.xu.1982.02.06@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *
+ *
+ * Author: Kevin XU <kevin.xu.1982.02.06@gmail.com>
+ *
+ */
+
+#ifndef __INLINE_FUNCTION_HPP
+# define __INLINE_FUNCTION_HPP
+
+# include <cstddef>
+
+# include <new>
+# include <stdexcept>
+# include <type_traits>
+# include <utility>
+
+
+
+template <class F, std::size_t SIZE = 32UL>
+class InlineFunction;
+
+template <class R, class ... As, std::size_t SIZE>
+class InlineFunction<R (As...), SIZE> {
+private:
+  static std::size_t constexpr _SIZE = SIZE < sizeof(void *) ? sizeof(void *) : SIZE;
+
+  template <class F>
+  using EIINIFVIT = typename std::enable_if<
+    !std::is_same<typename std::decay<F>::type, InlineFunction>::value,
+    int>::type;
+
+public:
+  InlineFunction(void) noexcept: _invoke(nullptr), _manage(nullptr) {}
+
+  InlineFunction(std::nullptr_t) noexcept: _invoke(nullptr), _manage(nullptr) {}
+
+  template <class F, EIINIFVIT<F> = 0>
+  InlineFunction(F &&f): _invoke(nullptr), _manage(nullptr)
+  {
+    typedef typename std::decay<F>::type _F;
+
+    if constexpr (INLINE<_F>::value)
+      new (_storage) _F(std::forward<F>(f));
+    else
+      *reinterpret_cast<_F **>(_storage) = new _F(std::forward<F>(f));
+
+    _invoke = &invoke<_F>;
+
+    _manage = &manage<_F>;
+  }
+
+  InlineFunction(InlineFunction const &inlineFunction):
+    _invoke(inlineFunction._invoke),
+    _manage(inlineFunction._manage)
+  {
+    if (_manage != nullptr)
+      (*_manage)(_COPY, _storage, inlineFunction._storage);
+  }
+
+  InlineFunction(InlineFunction &&inlineFunction) noexcept: _invoke(nullptr), _manage(nullptr)
+  {
+    move(inlineFunction);
+  }
+
+  ~InlineFunction()
+  {
+    if (_manage != nullptr)
+      (*_manage)(_DESTROY, _storage, nullptr);
+  }
+
+  InlineFunction &operator=(InlineFunction const &inlineFunction)
+  {
+    if (&inlineFunction != this)
+      InlineFunction(inlineFunction).swap(*this);
+
+    return *this;
+  }
+
+  InlineFunction &operator=(InlineFunction &&inlineFunction) noexcept
+  {
+    if (&inlineFunction != this)
+      InlineFunction(std::move(inlineFunction)).swap(*this);
+
+    return *this;
+  }
+
+  R operator()(As... arguments) const
+  {
+    if (_invoke == nullptr)
+      throw std::runtime_error("");
+
+    return (*_invoke)(_storage, std::forward<As>(arguments)...);
+  }
+
+  explicit operator bool() const noexcept
+  {
+    return _invoke != nullptr;
+  }
+
+  void swap(InlineFunction &inlineFunction) noexcept
+  {
+    InlineFunction temporary;
+
+    temporary.move(*this);
+
+    move(inlineFunction);
+
+    inlineFunction.move(temporary);
+  }
+
+  template <class F>
+  struct INLINE {
+    static bool constexpr value =
+      sizeof(F) <= _SIZE
+      && alignof(F) <= alignof(std::max_align_t)
+      && std::is_nothrow_move_constructible<F>::value;
+  };
+
+private:
+  enum _Operation {
+    _COPY,
+    _MOVE,
+    _DESTROY
+  };
+
+  typedef R (*_Invoke)(void *storage, As &&... arguments);
+
+  typedef void (*_Manage)(_Operation operation, void *storage, void *storage2);
+
+  _Invoke _invoke;
+
+  _Manage _manage;
+
+  alignas(std::max_align_t) mutable unsigned char _storage[_SIZE];
+
+  template <class F>
+  static F *get(void *storage) noexcept
+  {
+    if constexpr (INLINE<F>::value)
+      return reinterpret_cast<F *>(storage);
+    else
+      return *reinterpret_cast<F **>(storage);
+  }
+
+  template <class F>
+  static R invoke(void *storage, As &&... arguments)
+  {
+    return (*get<F>(storage))(std::forward<As>(arguments)...);
+  }
+
+  template <class F>
+  static void manage(_Operation operation, void *storage, void *storage2)
+  {
+    switch (operation) {
+    case _COPY:
+      if constexpr (std::is_copy_constructible<F>::value) {
+        if constexpr (INLINE<F>::value)
+          new (storage) F(*get<F>(storage2));
+        else
+          *reinterpret_cast<F **>(storage) = new F(*get<F>(storage2));
+      } else
+        throw std::runtime_error("");
+
+      break;
+
+    case _MOVE:
+      if constexpr (INLINE<F>::value) {
+        new (storage) F(std::move(*get<F>(storage2)));
+
+        get<F>(storage2)->~F();
+      } else
+        *reinterpret_cast<F **>(storage) = get<F>(storage2);
+
+      break;
+
+    case _DESTROY:
+      if constexpr (INLINE<F>::value)
+        get<F>(storage)->~F();
+      else
+        delete get<F>(storage);
+
+      break;
+    }
+  }
+
+  void move(InlineFunction &inlineFunction) noexcept
+  {
+    _invoke = inlineFunction._invoke;
+
+    _manage = inlineFunction._manage;
+
+    if (_manage != nullptr)
+      (*_manage)(_MOVE, _storage, inlineFunction._storage);
+
+    inlineFunction._invoke = nullptr;
+
+    inlineFunction._manage = nullptr;
+  }
+};
+
+#endif
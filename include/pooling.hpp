@@ -0,0 +1,364 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Kevin XU <kevin.xu.1982.02.06@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *
+ *
+ * Author: Kevin XU <kevin.xu.1982.02.06@gmail.com>
+ *
+ */
+
+#ifndef __POOLING_HPP
+# define __POOLING_HPP
+
+# include <cassert>
+# include <cstddef>
+# include <cstdint>
+
+# include <atomic>
+# include <mutex>
+# include <new>
+
+
+
+class Pooling {
+public:
+  class Arena;
+
+private:
+  struct _Chunk {
+    Arena *arena;
+
+    _Chunk *next;
+  };
+
+  struct _Block {
+    _Block *next;
+  };
+
+  static std::size_t constexpr _GRANULARITY = 16UL;
+
+  static std::size_t constexpr _N_SIZE_CLASSES = 16UL;
+
+  static std::size_t constexpr _MAX_SIZE = _GRANULARITY * _N_SIZE_CLASSES;
+
+  static std::size_t constexpr _CHUNK_SIZE = 65536UL;
+
+  static std::size_t constexpr _HEADER_SIZE =
+    (sizeof(_Chunk) + _GRANULARITY - 1UL) / _GRANULARITY * _GRANULARITY;
+
+  static std::size_t constexpr _BATCH = 32UL;
+
+public:
+  class Arena {
+  public:
+    Arena(void) noexcept:
+      _previous(_arena),
+      _chunk(nullptr),
+      _top(nullptr),
+      _limit(nullptr),
+      _nLives(0UL)
+    {
+      _arena = this;
+    }
+
+    ~Arena()
+    {
+      assert(_arena == this);
+
+      assert(_nLives.load(std::memory_order_acquire) == 0UL);
+
+      _arena = _previous;
+
+      while (_chunk != nullptr) {
+        _Chunk *next = _chunk->next;
+
+        ::operator delete(_chunk, std::align_val_t(_CHUNK_SIZE));
+
+        _chunk = next;
+      }
+    }
+
+  private:
+    Arena *_previous;
+
+    _Chunk *_chunk;
+
+    char *_top;
+
+    char *_limit;
+
+    std::atomic<std::size_t> _nLives;
+
+    void *allocate(std::size_t size)
+    {
+      if (static_cast<std::size_t>(_limit - _top) < size) {
+        _Chunk *chunk = newChunk(this);
+
+        chunk->next = _chunk, _chunk = chunk;
+
+        _top = reinterpret_cast<char *>(chunk) + _HEADER_SIZE;
+
+        _limit = reinterpret_cast<char *>(chunk) + _CHUNK_SIZE;
+      }
+
+      void *pointer = _top;
+
+      _top += size;
+
+      _nLives.fetch_add(1UL, std::memory_order_relaxed);
+
+      return pointer;
+    }
+
+    void deallocate(void) noexcept
+    {
+      _nLives.fetch_sub(1UL, std::memory_order_release);
+    }
+
+    Arena(Arena const &arena) = delete;
+
+    Arena &operator=(Arena const &arena) = delete;
+
+    friend class Pooling;
+  };
+
+  static void *operator new(std::size_t size)
+  {
+    if (size > _MAX_SIZE)
+      return ::operator new(size);
+
+    std::size_t _size = roundUp(size);
+
+    if (_arena != nullptr)
+      return _arena->allocate(_size);
+
+    std::size_t sizeClass = _size / _GRANULARITY - 1UL;
+
+    _Cache *cache = Pooling::cache();
+
+    if (cache == nullptr) {
+      std::size_t n = 1UL;
+
+      return refill(sizeClass, n);
+    }
+
+    _Block *block = cache->blocks[sizeClass];
+
+    if (block == nullptr) {
+      std::size_t n = _BATCH;
+
+      block = refill(sizeClass, n);
+
+      cache->nBlocks[sizeClass] += n;
+    }
+
+    cache->blocks[sizeClass] = block->next;
+
+    --cache->nBlocks[sizeClass];
+
+    return block;
+  }
+
+  static void *operator new(std::size_t size, std::align_val_t alignment)
+  {
+    return ::operator new(size, alignment);
+  }
+
+  static void *operator new(std::size_t size, void *pointer) noexcept
+  {
+    return pointer;
+  }
+
+  static void operator delete(void *pointer, std::size_t size) noexcept
+  {
+    if (size > _MAX_SIZE) {
+      ::operator delete(pointer);
+
+      return;
+    }
+
+    _Chunk *chunk = reinterpret_cast<_Chunk *>(
+        reinterpret_cast<std::uintptr_t>(pointer) & ~(_CHUNK_SIZE - 1UL));
+
+    if (chunk->arena != nullptr) {
+      chunk->arena->deallocate();
+
+      return;
+    }
+
+    std::size_t sizeClass = roundUp(size) / _GRANULARITY - 1UL;
+
+    _Block *block = static_cast<_Block *>(pointer);
+
+    _Cache *cache = Pooling::cache();
+
+    if (cache == nullptr) {
+      giveBack(sizeClass, block, block);
+
+      return;
+    }
+
+    block->next = cache->blocks[sizeClass], cache->blocks[sizeClass] = block;
+
+    if (++cache->nBlocks[sizeClass] >= _BATCH * 2UL)
+      drain(*cache, sizeClass, _BATCH);
+  }
+
+  static void operator delete(void *pointer, std::size_t size, std::align_val_t alignment) noexcept
+  {
+    ::operator delete(pointer, alignment);
+  }
+
+  static void operator delete(void *pointer, void *pointer2) noexcept {}
+
+protected:
+  Pooling(void) = default;
+
+  ~Pooling() = default;
+
+private:
+  struct _Global {
+    std::mutex mutex;
+
+    _Block *blocks[_N_SIZE_CLASSES];
+
+    _Chunk *chunk;
+  };
+
+  struct _Cache {
+    _Block *blocks[_N_SIZE_CLASSES];
+
+    std::size_t nBlocks[_N_SIZE_CLASSES];
+
+    ~_Cache()
+    {
+      _retired = true;
+
+      for (std::size_t i = 0UL; i < _N_SIZE_CLASSES; ++i)
+        drain(*this, i, nBlocks[i]);
+    }
+  };
+
+  static inline thread_local Arena *_arena = nullptr;
+
+  static inline thread_local bool _retired = false;
+
+  static std::size_t roundUp(std::size_t size) noexcept
+  {
+    return size == 0UL ? _GRANULARITY : (size + _GRANULARITY - 1UL) / _GRANULARITY * _GRANULARITY;
+  }
+
+  static _Global &global(void) noexcept
+  {
+    static _Global *global = new _Global{};
+
+    return *global;
+  }
+
+  static _Cache *cache(void) noexcept
+  {
+    if (_retired)
+      return nullptr;
+
+    static thread_local _Cache cache{};
+
+    return &cache;
+  }
+
+  static _Chunk *newChunk(Arena *arena)
+  {
+    void *pointer = ::operator new(_CHUNK_SIZE, std::align_val_t(_CHUNK_SIZE));
+
+    _Chunk *chunk = static_cast<_Chunk *>(pointer);
+
+    chunk->arena = arena;
+
+    chunk->next = nullptr;
+
+    return chunk;
+  }
+
+  static _Block *refill(std::size_t sizeClass, std::size_t &n)
+  {
+    _Global &global = Pooling::global();
+
+    std::lock_guard<std::mutex> lock(global.mutex);
+
+    _Block *&blocks = global.blocks[sizeClass];
+
+    if (blocks == nullptr) {
+      _Chunk *chunk = newChunk(nullptr);
+
+      chunk->next = global.chunk, global.chunk = chunk;
+
+      std::size_t size = (sizeClass + 1UL) * _GRANULARITY;
+
+      for (std::size_t i = (_CHUNK_SIZE - _HEADER_SIZE) / size; i > 0UL; --i) {
+        _Block *block = reinterpret_cast<_Block *>(
+            reinterpret_cast<char *>(chunk) + _HEADER_SIZE + (i - 1UL) * size);
+
+        block->next = blocks, blocks = block;
+      }
+    }
+
+    _Block *head = blocks, *tail = head;
+
+    std::size_t count = 1UL;
+
+    for (; count < n && tail->next != nullptr; ++count)
+      tail = tail->next;
+
+    blocks = tail->next;
+
+    tail->next = nullptr;
+
+    n = count;
+
+    return head;
+  }
+
+  static void drain(_Cache &cache, std::size_t sizeClass, std::size_t n) noexcept
+  {
+    if (n == 0UL)
+      return;
+
+    _Block *head = cache.blocks[sizeClass], *tail = head;
+
+    for (std::size_t i = 1UL; i < n; ++i)
+      tail = tail->next;
+
+    cache.blocks[sizeClass] = tail->next;
+
+    cache.nBlocks[sizeClass] -= n;
+
+    giveBack(sizeClass, head, tail);
+  }
+
+  static void giveBack(std::size_t sizeClass, _Block *head, _Block *tail) noexcept
+  {
+    _Global &global = Pooling::global();
+
+    std::lock_guard<std::mutex> lock(global.mutex);
+
+    tail->next = global.blocks[sizeClass], global.blocks[sizeClass] = head;
+  }
+};
+
+#endif
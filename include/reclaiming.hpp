@@ -0,0 +1,275 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Kevin XU <kevin.xu.1982.02.06@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *
+ *
+ * Author: Kevin XU <kevin.xu.1982.02.06@gmail.com>
+ *
+ */
+
+#ifndef __RECLAIMING_HPP
+# define __RECLAIMING_HPP
+
+# include <cassert>
+# include <cstddef>
+
+# include <atomic>
+# include <condition_variable>
+# include <limits>
+# include <mutex>
+# include <thread>
+# include <type_traits>
+# include <utility>
+# include <vector>
+
+# include "ref-counting.hpp"
+
+
+
+template <class RC>
+class Deferring;
+
+class Reclaiming {
+private:
+  struct _Retired {
+    void const *pointer;
+
+    void (*release)(void const *pointer);
+  };
+
+  typedef std::vector<_Retired> _Batch;
+
+  static std::size_t constexpr _BATCH = 64UL;
+
+public:
+  class Reclaimer {
+  public:
+    Reclaimer(void): _stopping(false)
+    {
+      _Global &global = Reclaiming::global();
+
+      std::lock_guard<std::mutex> lock(global.mutex);
+
+      assert(global.reclaimer.load(std::memory_order_relaxed) == nullptr);
+
+      global.reclaimer.store(this, std::memory_order_relaxed);
+
+      _thread = std::thread(&Reclaimer::run, this);
+    }
+
+    ~Reclaimer()
+    {
+      _Global &global = Reclaiming::global();
+
+      {
+        std::lock_guard<std::mutex> lock(global.mutex);
+
+        _stopping = true;
+      }
+
+      global.condition.notify_one();
+
+      _thread.join();
+    }
+
+  private:
+    bool _stopping;
+
+    std::thread _thread;
+
+    void run(void)
+    {
+      _Global &global = Reclaiming::global();
+
+      _reclaiming = true;
+
+      std::unique_lock<std::mutex> lock(global.mutex);
+
+      for (;;) {
+        global.condition.wait(lock, [&] () { return !global.batches.empty() || _stopping; });
+
+        if (global.batches.empty())
+          break;
+
+        _Batch batch = std::move(global.batches.back());
+
+        global.batches.pop_back();
+
+        lock.unlock();
+
+        for (auto i = batch.begin(), end = batch.end(); i != end; ++i)
+          i->release(i->pointer);
+
+        reclaim();
+
+        lock.lock();
+      }
+
+      global.reclaimer.store(nullptr, std::memory_order_relaxed);
+    }
+
+    Reclaimer(Reclaimer const &reclaimer) = delete;
+
+    Reclaimer &operator=(Reclaimer const &reclaimer) = delete;
+  };
+
+  static std::size_t reclaim(std::size_t limit = std::numeric_limits<std::size_t>::max())
+  {
+    _Local &local = Reclaiming::local();
+
+    std::size_t n = 0UL;
+
+    for (; n < limit && !(local.batch.empty() && local.pinned.empty()); ++n) {
+      _Batch &batch = local.batch.empty() ? local.pinned : local.batch;
+
+      _Retired retired = batch.back();
+
+      batch.pop_back();
+
+      retired.release(retired.pointer);
+    }
+
+    return n;
+  }
+
+  static std::size_t pending(void) noexcept
+  {
+    _Local &local = Reclaiming::local();
+
+    return local.batch.size() + local.pinned.size();
+  }
+
+  // Only objects whose counting is thread-safe are handed off. The others may still be referenced
+  // through non-atomic counts on this thread, so they stay pinned until it reclaims them.
+  static bool handOff(void)
+  {
+    _Batch &batch = local().batch;
+
+    if (batch.empty() || _reclaiming)
+      return false;
+
+    _Global &global = Reclaiming::global();
+
+    {
+      std::lock_guard<std::mutex> lock(global.mutex);
+
+      if (global.reclaimer.load(std::memory_order_relaxed) == nullptr)
+        return false;
+
+      global.batches.push_back(std::move(batch));
+    }
+
+    global.condition.notify_one();
+
+    batch.clear();
+
+    return true;
+  }
+
+private:
+  struct _Global {
+    std::mutex mutex;
+
+    std::condition_variable condition;
+
+    std::atomic<Reclaimer *> reclaimer;
+
+    std::vector<_Batch> batches;
+  };
+
+  struct _Local {
+    _Batch batch;
+
+    _Batch pinned;
+
+    ~_Local()
+    {
+      reclaim();
+    }
+  };
+
+  static inline thread_local bool _reclaiming = false;
+
+  static _Global &global(void) noexcept
+  {
+    static _Global global{};
+
+    return global;
+  }
+
+  static _Local &local(void) noexcept
+  {
+    static thread_local _Local local;
+
+    return local;
+  }
+
+  static void retire(void const *pointer, void (*release)(void const *pointer), bool shareable)
+  {
+    _Local &local = Reclaiming::local();
+
+    if (!shareable) {
+      local.pinned.push_back(_Retired{pointer, release});
+
+      return;
+    }
+
+    _Batch &batch = local.batch;
+
+    batch.push_back(_Retired{pointer, release});
+
+    if (batch.size() >= _BATCH && global().reclaimer.load(std::memory_order_relaxed) != nullptr)
+      handOff();
+  }
+
+  template <class RC>
+  friend class Deferring;
+
+  Reclaiming(void) = delete;
+};
+
+template <class RC>
+class Deferring: public RC {
+  static_assert(std::is_base_of<RefCountingBase, RC>::value, "");
+
+  static_assert(std::has_virtual_destructor<RC>::value, "");
+
+  static bool constexpr _SHAREABLE =
+    std::is_base_of<AtomicRefCounting, RC>::value
+    || std::is_base_of<BiasedRefCounting, RC>::value;
+protected:
+  template <class ... As>
+  Deferring(As &&... arguments): RC(std::forward<As>(arguments)...) {}
+
+  ~Deferring() = default;
+
+  void dispose(void) const override
+  {
+    Reclaiming::retire(this, &Deferring::release, _SHAREABLE);
+  }
+
+private:
+  static void release(void const *pointer)
+  {
+    static_cast<Deferring const *>(pointer)->RC::dispose();
+  }
+};
+
+#endif
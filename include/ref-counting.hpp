@@ -29,17 +29,61 @@
 
 # include <cstddef>
 
+# include <atomic>
 # include <new>
 # include <type_traits>
 
 
 
-class RefCounting {
+class RefCountingBase {
+protected:
+  constexpr RefCountingBase(void) noexcept = default;
+
+  ~RefCountingBase() = default;
+
+private:
+  static void *operator new [](std::size_t size) = delete;
+  static void operator delete [](void *pointer) noexcept = delete;
+
+  static void *operator new [](std::size_t size, std::nothrow_t const &nothrow) noexcept = delete;
+  static void operator delete [](void *pointer, std::nothrow_t const &nothrow) noexcept = delete;
+
+  static void *operator new [](std::size_t size, void *pointer) noexcept = delete;
+  static void operator delete [](void *pointer, void *pointer2) noexcept = delete;
+
+  RefCountingBase(RefCountingBase const &refCountingBase) = delete;
+
+  RefCountingBase(RefCountingBase &&refCountingBase) = delete;
+
+  RefCountingBase &operator=(RefCountingBase const &refCountingBase) = delete;
+
+  RefCountingBase &operator=(RefCountingBase &&refCountingBase) = delete;
+};
+
+template <class D>
+class StaticRefCounting;
+
+class RefCounting: public RefCountingBase {
 private:
+  template <class T>
+  struct _Deleted {
+    template <class D>
+    static D *deleted(StaticRefCounting<D> const *pointer) noexcept;
+
+    static T *deleted(void const *pointer) noexcept;
+
+    typedef typename std::remove_pointer<decltype(deleted((T const *)nullptr))>::type Type;
+
+    static bool constexpr value =
+      std::is_same<Type, T>::value || std::has_virtual_destructor<Type>::value;
+  };
+
   template <class T>
   struct _CHECK {
     static bool constexpr value =
-      std::is_base_of<RefCounting, T>::value && !std::is_destructible<T>::value;
+      std::is_base_of<RefCountingBase, T>::value
+      && !std::is_destructible<T>::value
+      && _Deleted<T>::value;
   };
 
 public:
@@ -70,7 +114,7 @@ public:
   void deref(void) const
   {
     if (--_count == 0U)
-      delete this;
+      dispose();
   }
 
 protected:
@@ -78,25 +122,313 @@ protected:
 
   virtual ~RefCounting() = default;
 
+  virtual void dispose(void) const
+  {
+    delete this;
+  }
+
+  unsigned count(void) const noexcept
+  {
+    return _count;
+  }
+
 private:
   mutable unsigned _count;
+};
 
-  static void *operator new [](std::size_t size) = delete;
-  static void operator delete [](void *pointer) noexcept = delete;
+class AtomicRefCounting: public RefCountingBase {
+public:
+  void ref(void) const noexcept
+  {
+    _count.fetch_add(1U, std::memory_order_relaxed);
+  }
 
-  static void *operator new [](std::size_t size, std::nothrow_t const &nothrow) noexcept = delete;
-  static void operator delete [](void *pointer, std::nothrow_t const &nothrow) noexcept = delete;
+  template <class T>
+  T *ref(void) noexcept
+  {
+    ref();
 
-  static void *operator new [](std::size_t size, void *pointer) noexcept = delete;
-  static void operator delete [](void *pointer, void *pointer2) noexcept = delete;
+    return static_cast<T *>(this);
+  }
+
+  template <class T>
+  T const *ref(void) const noexcept
+  {
+    ref();
+
+    return static_cast<T const *>(this);
+  }
+
+  void deref(void) const
+  {
+    if (_count.fetch_sub(1U, std::memory_order_release) != 1U)
+      return;
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    dispose();
+  }
+
+protected:
+  constexpr AtomicRefCounting(void) noexcept: _count(1U) {}
+
+  virtual ~AtomicRefCounting() = default;
+
+  virtual void dispose(void) const
+  {
+    delete this;
+  }
+
+  unsigned count(void) const noexcept
+  {
+    return _count.load(std::memory_order_acquire);
+  }
+
+private:
+  mutable std::atomic<unsigned> _count;
+};
+
+class BiasedRefCounting: public RefCountingBase {
+public:
+  void ref(void) const noexcept
+  {
+    if (_owner == _current && _biased != 0U)
+      ++_biased;
+    else
+      _shared.fetch_add(_UNIT, std::memory_order_relaxed);
+  }
+
+  template <class T>
+  T *ref(void) noexcept
+  {
+    ref();
+
+    return static_cast<T *>(this);
+  }
+
+  template <class T>
+  T const *ref(void) const noexcept
+  {
+    ref();
+
+    return static_cast<T const *>(this);
+  }
+
+  void deref(void) const
+  {
+    if (_owner == _current && _biased != 0U) {
+      if (--_biased == 0U)
+        unbias();
+
+      return;
+    }
+
+    long shared = _shared.fetch_sub(_UNIT, std::memory_order_release) - _UNIT;
+
+    if (shared >= _UNIT)
+      return;
 
-  RefCounting(RefCounting const &refCounting) = delete;
+    if ((shared & _MERGED) == 0L) {
+      if (shared < 0L)
+        enqueue();
 
-  RefCounting(RefCounting &&refCounting) = delete;
+      return;
+    }
 
-  RefCounting &operator=(RefCounting const &refCounting) = delete;
+    if (shared != _MERGED)
+      return;
 
-  RefCounting &operator=(RefCounting &&refCounting) = delete;
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    dispose();
+  }
+
+  static void collect(void)
+  {
+    if (_current == nullptr)
+      return;
+
+    merge(_current->inbox.exchange(nullptr, std::memory_order_acquire));
+  }
+
+protected:
+  BiasedRefCounting(void): _owner(attach()), _biased(1U), _shared(0L), _next(nullptr)
+  {
+    _owner->count.fetch_add(1U, std::memory_order_relaxed);
+  }
+
+  virtual ~BiasedRefCounting()
+  {
+    _owner->deref();
+  }
+
+  virtual void dispose(void) const
+  {
+    delete this;
+  }
+
+private:
+  struct _Owner {
+    std::atomic<BiasedRefCounting const *> inbox;
+
+    std::atomic<unsigned> count;
+
+    void deref(void) noexcept
+    {
+      if (count.fetch_sub(1U, std::memory_order_acq_rel) == 1U)
+        delete this;
+    }
+  };
+
+  class _Attachment {
+  public:
+    _Owner *owner;
+
+    _Attachment(void): owner(new _Owner{{nullptr}, {1U}})
+    {
+      _current = owner;
+    }
+
+    ~_Attachment()
+    {
+      _current = nullptr;
+
+      merge(owner->inbox.exchange(dead(), std::memory_order_acq_rel));
+
+      owner->deref();
+    }
+  };
+
+  static long constexpr _MERGED = 1L;
+
+  static long constexpr _QUEUED = 2L;
+
+  static long constexpr _UNIT = 4L;
+
+  static inline char _dead = '\0';
+
+  static inline thread_local _Owner *_current = nullptr;
+
+  _Owner *const _owner;
+
+  mutable unsigned _biased;
+
+  mutable std::atomic<long> _shared;
+
+  mutable BiasedRefCounting const *_next;
+
+  static _Owner *attach(void)
+  {
+    static thread_local _Attachment attachment;
+
+    return attachment.owner;
+  }
+
+  static BiasedRefCounting const *dead(void) noexcept
+  {
+    return reinterpret_cast<BiasedRefCounting const *>(&_dead);
+  }
+
+  static void merge(BiasedRefCounting const *biasedRefCounting)
+  {
+    while (biasedRefCounting != nullptr) {
+      BiasedRefCounting const *next = biasedRefCounting->_next;
+
+      biasedRefCounting->merge();
+
+      biasedRefCounting = next;
+    }
+  }
+
+  void unbias(void) const
+  {
+    long shared = _shared.fetch_or(_MERGED, std::memory_order_acq_rel);
+
+    if (_current->inbox.load(std::memory_order_relaxed) != nullptr)
+      collect();
+
+    if ((shared & ~_MERGED) == 0L)
+      dispose();
+  }
+
+  void enqueue(void) const
+  {
+    if ((_shared.fetch_or(_QUEUED, std::memory_order_relaxed) & _QUEUED) != 0L)
+      return;
+
+    BiasedRefCounting const *next = _owner->inbox.load(std::memory_order_acquire);
+
+    do {
+      if (next == dead()) {
+        merge();
+
+        return;
+      }
+
+      _next = next;
+    } while (!_owner->inbox.compare_exchange_weak(
+          next,
+          this,
+          std::memory_order_release,
+          std::memory_order_acquire));
+  }
+
+  void merge(void) const
+  {
+    long biased = static_cast<long>(_biased) * _UNIT;
+
+    _biased = 0U;
+
+    long shared = _shared.load(std::memory_order_relaxed);
+
+    long merged;
+
+    do
+      merged = ((shared + biased) | _MERGED) & ~_QUEUED;
+    while (!_shared.compare_exchange_weak(shared, merged, std::memory_order_acq_rel));
+
+    if (merged == _MERGED)
+      dispose();
+  }
+};
+
+template <class D>
+class StaticRefCounting: public RefCountingBase {
+public:
+  void ref(void) const noexcept
+  {
+    ++_count;
+  }
+
+  template <class T>
+  T *ref(void) noexcept
+  {
+    ref();
+
+    return static_cast<T *>(this);
+  }
+
+  template <class T>
+  T const *ref(void) const noexcept
+  {
+    ref();
+
+    return static_cast<T const *>(this);
+  }
+
+  void deref(void) const
+  {
+    if (--_count == 0U)
+      delete static_cast<D const *>(this);
+  }
+
+protected:
+  constexpr StaticRefCounting(void) noexcept: _count(1U) {}
+
+  ~StaticRefCounting() = default;
+
+private:
+  mutable unsigned _count;
 };
 
 #endif
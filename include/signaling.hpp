@@ -28,13 +28,23 @@
 # define __SIGNALING_HPP
 
 # include <cassert>
+# include <cstddef>
 
-# include <deque>
-# include <map>
+# include <mutex>
+# include <new>
+# include <optional>
 # include <stdexcept>
 # include <tuple>
 # include <type_traits>
 # include <utility>
+# include <vector>
+
+# include "atomic-auto-ptr.hpp"
+# include "auto-ptr.hpp"
+# include "executor.hpp"
+# include "ref-counting.hpp"
+# include "small-vector.hpp"
+# include "weak-ptr.hpp"
 
 
 
@@ -65,13 +75,30 @@ public:
 
   using DetachData = void (*)(void *data) noexcept;
 
+  template <class M>
+  using EIIMFPVIT = typename std::enable_if<std::is_member_function_pointer<M>::value, int>::type;
+
+  template <class F>
+  using EIINFPVIT =
+    typename std::enable_if<!std::is_pointer<typename std::decay<F>::type>::value, int>::type;
+
 private:
+  template <class ... As>
+  struct _Arguments {};
+
   template <class ... As>
   struct _SIGNATURE {
     template <class S, EIIBOSSVIT<S> = 0>
     using SLOT = Slot<S, As...>;
+
+    typedef _Arguments<As...> ARGUMENTS;
+
+    typedef std::tuple<typename std::decay<As>::type...> EVENT;
   };
 
+  template <class ... As>
+  struct _SIGNATURE<void, As...>: _SIGNATURE<As...> {};
+
 public:
   template <class ... As>
   using SIGNATURE = _SIGNATURE<As...>;
@@ -79,46 +106,155 @@ public:
   template <class S, int signal, EIIBOSSVIT<S> = 0>
   struct SIGNALIZE {};
 
+  template <class S, int signal>
+  using EVENT = typename SIGNALIZE<S, signal>::SIGNATURE::EVENT;
+
+  template <class E>
+  class Batch {
+  public:
+    Batch(E const *events, std::size_t size) noexcept: _events(events), _size(size) {}
+
+    E const *begin(void) const noexcept
+    {
+      return _events;
+    }
+
+    E const *end(void) const noexcept
+    {
+      return _events + _size;
+    }
+
+    std::size_t size(void) const noexcept
+    {
+      return _size;
+    }
+
+    E const &operator[](std::size_t index) const noexcept
+    {
+      return _events[index];
+    }
+
+  private:
+    E const *const _events;
+
+    std::size_t const _size;
+  };
+
+  template <class S, int signal>
+  using BATCH = Batch<EVENT<S, signal>>;
+
+private:
+  static int constexpr _MAX_SIGNALS = 256;
+
+  template <class S, int signal, class = void>
+  struct _Signalized {
+    static bool constexpr value = false;
+  };
+
+  template <class S, int signal>
+  struct _Signalized<S, signal, std::void_t<typename SIGNALIZE<S, signal>::SIGNATURE>> {
+    static bool constexpr value = true;
+  };
+
+  template <class S, int count>
+  struct _COUNT {
+    static int constexpr value =
+      _Signalized<S, count - 1>::value ? count : _COUNT<S, count - 1>::value;
+  };
+
+  template <class S>
+  struct _COUNT<S, 0> {
+    static int constexpr value = 0;
+  };
+
+public:
+  // Signal ids run from 0 to COUNT - 1, and every observed object keeps one record per id in that
+  // range, so ids should be dense. COUNT defaults to one past the highest id with a SIGNALIZE
+  // specialization, found by probing ids below 256. A class with higher ids must specialize
+  // SIGNALS and state COUNT itself.
+  template <class S, EIIBOSSVIT<S> = 0>
+  struct SIGNALS {
+    static int constexpr COUNT = _COUNT<S, _MAX_SIGNALS>::value;
+
+    static bool constexpr CONCURRENT = false;
+  };
+
+private:
+  template <class S, class = void>
+  struct _CONCURRENT {
+    static bool constexpr value = false;
+  };
+
+  template <class S>
+  struct _CONCURRENT<S, std::void_t<decltype(SIGNALS<S>::CONCURRENT)>> {
+    static bool constexpr value = SIGNALS<S>::CONCURRENT;
+  };
+
+public:
+  struct Coalescing {
+    Executor::Clock::duration interval;
+  };
+
+  struct Priority {
+    int value;
+  };
+
   struct ConnectionId {
     int signal;
 
     unsigned subconnectionId;
+
+    unsigned generation;
   };
 
-  template <int signal, class S, class ... AsD>
-  static ConnectionId connect(
-      S *self,
-      Slot2<S, AsD...> slot,
-      void *data,
-      DetachData detachData = nullptr)
+  template <int signal, class S, class ... Ts>
+  static ConnectionId connect(S *self, Ts &&... values)
+  {
+    return connect<signal>(self, Priority{0}, std::forward<Ts>(values)...);
+  }
+
+  template <int signal, class S, class ... Ts>
+  static ConnectionId connect(S *self, Priority priority, Ts &&... values)
   {
     static_assert(!std::is_const<S>::value, "");
 
     static_assert(std::is_base_of<Signaling, S>::value, "");
 
-    typedef typename SIGNALIZE<S, signal>::SIGNATURE _SIGNATURE;
+    static_assert(signal >= 0, "Signal ids must not be negative");
 
-    static_assert(IsInstanceOfSIGNATURE<_SIGNATURE>::value, "");
+    static_assert(signal < SIGNALS<S>::COUNT, "Signal id must be below SIGNALS<S>::COUNT");
 
-    static_assert(std::is_same<Slot2<S, AsD...>, typename _SIGNATURE::template SLOT<S>>::value, "");
+    return static_cast<Signaling *>(self)->connect(
+        signal,
+        SIGNALS<S>::COUNT,
+        _CONCURRENT<S>::value,
+        make<signal>(self, std::forward<Ts>(values)...),
+        priority.value);
+  }
 
-    return static_cast<Signaling *>(self)->connect(signal, (Slot0)slot, data, detachData);
+  template <int signal, auto method, class S, class ... Ts>
+  static ConnectionId connect(S *self, Ts &&... values)
+  {
+    return connect<signal, method>(self, Priority{0}, std::forward<Ts>(values)...);
   }
 
-  template <int signal, class S, class ... As>
-  static ConnectionId connect(S *self, Slot2<S, As...> slot)
+  template <int signal, auto method, class S, class ... Ts>
+  static ConnectionId connect(S *self, Priority priority, Ts &&... values)
   {
     static_assert(!std::is_const<S>::value, "");
 
     static_assert(std::is_base_of<Signaling, S>::value, "");
 
-    typedef typename SIGNALIZE<S, signal>::SIGNATURE _SIGNATURE;
-
-    static_assert(IsInstanceOfSIGNATURE<_SIGNATURE>::value, "");
+    static_assert(signal >= 0, "Signal ids must not be negative");
 
-    static_assert(std::is_same<Slot<S, As...>, typename _SIGNATURE::template SLOT<S>>::value, "");
+    static_assert(signal < SIGNALS<S>::COUNT, "Signal id must be below SIGNALS<S>::COUNT");
 
-    return static_cast<Signaling *>(self)->connect(signal, (Slot0)slot, nullptr, nullptr);
+    return static_cast<Signaling *>(self)->connect(
+        signal,
+        SIGNALS<S>::COUNT,
+        _CONCURRENT<S>::value,
+        make<signal, method>(self, std::forward<Ts>(values)...),
+        priority.value);
   }
 
   void disconnect(ConnectionId const &connectionId)
@@ -127,98 +263,118 @@ public:
 
     unsigned subconnectionId = connectionId.subconnectionId;
 
-    auto ismsi2sddd = _ms2msi2sddd.find(signal);
-
-    if (ismsi2sddd == _ms2msi2sddd.end())
-      return;
+    unsigned generation = connectionId.generation;
 
-    MUTSPVDD &msi2sddd = ismsi2sddd->second;
+    update([&] (_Table &table) {
+      if (signal >= 0 && static_cast<std::size_t>(signal) < table.signals.size())
+        table.signals[signal].disconnect(subconnectionId, generation);
+    });
+  }
 
-    auto isisddd = msi2sddd.find(subconnectionId);
+  void disconnect(int signal)
+  {
+    update([&] (_Table &table) {
+      if (signal >= 0 && static_cast<std::size_t>(signal) < table.signals.size())
+        table.signals[signal].disconnect();
+    });
+  }
 
-    if (isisddd == msi2sddd.end())
-      return;
+  void disconnect(void)
+  {
+    update([&] (_Table &table) {
+      for (auto i = table.signals.begin(), end = table.signals.end(); i != end; ++i)
+        i->disconnect();
+    });
+  }
 
-    _ms2dsi[signal].emplace_back(subconnectionId);
+protected:
+  Signaling(void) = default;
 
-    TSPVDD const &sddd = isisddd->second;
+  Signaling(Signaling const &signaling): _table(share(signaling)) {}
 
-    void *data = std::get<1UL>(sddd);
+  Signaling(Signaling &&signaling) noexcept: _table(signaling._table.exchange(nullptr)) {}
 
-    DetachData detachData = std::get<2UL>(sddd);
+  ~Signaling() = default;
 
-    if (detachData != nullptr)
-      (*detachData)(data);
+  Signaling &operator=(Signaling const &signaling)
+  {
+    if (&signaling != this)
+      _table.store(share(signaling));
 
-    msi2sddd.erase(subconnectionId);
+    return *this;
   }
 
-  void disconnect(int signal) noexcept
+  Signaling &operator=(Signaling &&signaling) noexcept
   {
-    auto ismsi2sddd = _ms2msi2sddd.find(signal);
-
-    if (ismsi2sddd == _ms2msi2sddd.end())
-      return;
+    if (&signaling != this)
+      _table.store(signaling._table.exchange(nullptr));
 
-    disconnect(*ismsi2sddd);
+    return *this;
   }
 
-  void disconnect(void) noexcept
+  template <int signal, class S, class ... As>
+  static void emit(S *self, As &&... arguments) noexcept
   {
-    if (_ms2msi2sddd.empty())
-      return;
+    static_assert(!std::is_const<S>::value, "");
 
-    for (auto i = _ms2msi2sddd.begin(), end = _ms2msi2sddd.end(); i != end; ++i)
-      disconnect(*i);
-  }
+    static_assert(std::is_base_of<Signaling, S>::value, "");
 
-protected:
-  Signaling(void) = default;
+    static_assert(signal >= 0, "Signal ids must not be negative");
 
-  Signaling(Signaling const &signaling) = default;
+    static_assert(signal < SIGNALS<S>::COUNT, "Signal id must be below SIGNALS<S>::COUNT");
 
-  Signaling(Signaling &&signaling) = default;
+    typedef typename SIGNALIZE<S, signal>::SIGNATURE _SIGNATURE;
 
-  ~Signaling() = default;
+    static_assert(IsInstanceOfSIGNATURE<_SIGNATURE>::value, "");
 
-  Signaling &operator=(Signaling const &signaling) = default;
+    if (!static_cast<Signaling *>(self)->template observed<_CONCURRENT<S>::value>(signal))
+      return;
 
-  Signaling &operator=(Signaling &&signaling) = default;
+    _Emission<S, typename _SIGNATURE::ARGUMENTS>::template emit<signal>(
+        self,
+        std::forward<As>(arguments)...);
+  }
 
-  template <int signal, class S, class ... As>
-  static void emit(S *self, As... arguments) noexcept
+  template <int signal, class S>
+  static void emitBatch(S *self, EVENT<S, signal> const *events, std::size_t size) noexcept
   {
     static_assert(!std::is_const<S>::value, "");
 
     static_assert(std::is_base_of<Signaling, S>::value, "");
 
+    static_assert(signal >= 0, "Signal ids must not be negative");
+
+    static_assert(signal < SIGNALS<S>::COUNT, "Signal id must be below SIGNALS<S>::COUNT");
+
     typedef typename SIGNALIZE<S, signal>::SIGNATURE _SIGNATURE;
 
     static_assert(IsInstanceOfSIGNATURE<_SIGNATURE>::value, "");
 
     typedef typename _SIGNATURE::template SLOT<S> _Slot;
 
-    Signaling *_self = static_cast<Signaling *>(self);
-
-    auto ismsi2sddd = _self->_ms2msi2sddd.find(signal);
-
-    if (ismsi2sddd == _self->_ms2msi2sddd.end())
+    if (size == 0UL
+        || !static_cast<Signaling *>(self)->template observed<_CONCURRENT<S>::value>(signal))
       return;
 
-    MUTSPVDD const &msi2sddd = ismsi2sddd->second;
+    _BatchContext context{self, events, size, false};
 
-    if (msi2sddd.empty())
-      return;
-
-    for (auto i = msi2sddd.cbegin(), end = msi2sddd.cend(); i != end; ++i) {
-      TSPVDD const &sddd = i->second;
+    static_cast<Signaling *>(self)->template each<_CONCURRENT<S>::value>(
+        signal,
+        [&] (_Connection const &connection) {
+          if (connection.deliver(context))
+            return;
 
-      _Slot slot = (_Slot)std::get<0UL>(sddd);
+          _Slot slot = (_Slot)connection.slot;
 
-      void *data = std::get<1UL>(sddd);
+          void *data = connection.context();
 
-      (*slot)(*self, arguments..., data);
-    }
+          for (std::size_t i = 0UL; i < size; ++i)
+            std::apply(
+                [&] (auto const &... arguments) {
+                  (*slot)(*self, arguments..., data);
+                },
+                events[i]);
+        });
   }
 
 private:
@@ -232,79 +388,1321 @@ private:
     static bool constexpr value = true;
   };
 
-  typedef std::map<int, unsigned> MIU;
+  class _Detachment final: public AtomicRefCounting {
+  public:
+    _Detachment(void *data, DetachData detachData) noexcept: _data(data), _detachData(detachData)
+    {}
+
+  private:
+    void *const _data;
 
-  typedef std::deque<unsigned> DU;
-  typedef std::map<int, DU> MIDU;
+    DetachData const _detachData;
 
-  typedef std::tuple<Slot0, void *, DetachData> TSPVDD;
-  typedef std::map<unsigned, TSPVDD> MUTSPVDD;
-  typedef std::map<int, MUTSPVDD> MIMUTSPVDD;
+    ~_Detachment()
+    {
+      (*_detachData)(_data);
+    }
+  };
 
-  MIU _ms2si;
+  template <class S, class A>
+  struct _Emission;
+
+  template <class S, class ... Ps>
+  struct _Emission<S, _Arguments<Ps...>> {
+    template <int signal>
+    static void emit(S *self, Ps... arguments) noexcept
+    {
+      static_cast<Signaling *>(self)->template each<_CONCURRENT<S>::value>(
+          signal,
+          [&] (_Connection const &connection) {
+            (*(Slot<S, Ps...>)connection.slot)(*self, arguments..., connection.context());
+          });
+    }
+  };
 
-  MIDU _ms2dsi;
+  template <class S>
+  class _Sender {
+    static bool constexpr _PINNED =
+      std::is_base_of<AtomicRefCounting, S>::value
+      || std::is_base_of<BiasedRefCounting, S>::value;
 
-  MIMUTSPVDD _ms2msi2sddd;
+    static_assert(_PINNED || !std::is_base_of<RefCountingBase, S>::value, "");
+  public:
+    _Sender(void) noexcept: _pointer() {}
 
-  ConnectionId connect(int signal, Slot0 slot, void *data, DetachData detachData)
-  {
-    if (slot == nullptr)
-      throw std::runtime_error("");
+    explicit _Sender(S &signaling) noexcept: _pointer(&signaling) {}
+
+    S *pointer(void) const noexcept
+    {
+      return _pointer;
+    }
+
+  private:
+    typename std::conditional<_PINNED, AutoPtr<S>, S *>::type _pointer;
+  };
+
+  template <class S, class A>
+  class _Queued;
+
+  template <class S, class ... As>
+  class _Queued<S, _Arguments<As...>> final: public AtomicRefCounting {
+  public:
+    _Queued(
+        Executor &executor,
+        Slot<S, As...> slot,
+        void *data,
+        AutoPtr<AtomicRefCounting> attachment) noexcept:
+      _executor(executor),
+      _slot(slot),
+      _data(data),
+      _attachment(std::move(attachment))
+    {}
+
+    static void queue(S &signaling, As... arguments, void *data) noexcept
+    {
+      _Queued *queued = static_cast<_Queued *>(data);
+
+      queued->_executor.post(
+          [queued = AutoPtr<_Queued>(queued),
+           sender = _Sender<S>(signaling),
+           arguments = std::make_tuple(arguments...)] () {
+            std::apply(
+                [&] (auto &... arguments) {
+                  (*queued->_slot)(*sender.pointer(), arguments..., queued->_data);
+                },
+                arguments);
+          });
+    }
+
+  private:
+    Executor &_executor;
+
+    Slot<S, As...> const _slot;
+
+    void *const _data;
+
+    AutoPtr<AtomicRefCounting> const _attachment;
+
+    ~_Queued() = default;
+  };
+
+  template <class S, class A>
+  class _Coalesced;
+
+  template <class S, class ... As>
+  class _Coalesced<S, _Arguments<As...>> final: public AtomicRefCounting {
+  public:
+    _Coalesced(
+        Executor &executor,
+        Coalescing const &coalescing,
+        Slot<S, As...> slot,
+        void *data,
+        AutoPtr<AtomicRefCounting> attachment) noexcept:
+      _executor(executor),
+      _interval(coalescing.interval),
+      _slot(slot),
+      _data(data),
+      _attachment(std::move(attachment)),
+      _scheduled(false)
+    {}
+
+    static void queue(S &signaling, As... arguments, void *data) noexcept
+    {
+      _Coalesced *coalesced = static_cast<_Coalesced *>(data);
+
+      {
+        std::lock_guard<std::mutex> lock(coalesced->_mutex);
+
+        coalesced->_sender = _Sender<S>(signaling);
+
+        coalesced->_event = _Event(arguments...);
+
+        if (coalesced->_scheduled)
+          return;
+
+        coalesced->_scheduled = true;
+      }
+
+      coalesced->schedule();
+    }
+
+  private:
+    typedef std::tuple<typename std::decay<As>::type...> _Event;
+
+    Executor &_executor;
+
+    Executor::Clock::duration const _interval;
+
+    Slot<S, As...> const _slot;
+
+    void *const _data;
+
+    AutoPtr<AtomicRefCounting> const _attachment;
+
+    std::mutex _mutex;
+
+    _Sender<S> _sender;
+
+    std::optional<_Event> _event;
+
+    bool _scheduled;
+
+    Executor::Clock::time_point _time;
+
+    ~_Coalesced() = default;
+
+    void schedule(void)
+    {
+      Executor::Clock::time_point time;
+
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        time = _time;
+      }
+
+      _executor.post(
+          [coalesced = AutoPtr<_Coalesced>(this)] () {
+            coalesced->deliver();
+          },
+          time);
+    }
+
+    void deliver(void)
+    {
+      _Sender<S> sender;
+
+      std::optional<_Event> event;
+
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        std::swap(sender, _sender);
+
+        event.swap(_event);
+      }
+
+      std::apply(
+          [&] (auto &... arguments) {
+            (*_slot)(*sender.pointer(), arguments..., _data);
+          },
+          *event);
+
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        _time = Executor::Clock::now() + _interval;
+
+        if (!_event.has_value()) {
+          _scheduled = false;
+
+          return;
+        }
+      }
+
+      schedule();
+    }
+  };
+
+  static std::size_t constexpr _INLINE_SIZE = 32UL;
+
+  static std::size_t constexpr _INLINE_CONNECTIONS = 2UL;
+
+  enum _Operation {
+    _COPY,
+    _MOVE,
+    _DESTROY,
+    _TRACKED,
+    _EXPIRED,
+    _BATCH
+  };
+
+  typedef void (*_Manage)(_Operation operation, void *storage, void *storage2);
+
+  struct _BatchContext {
+    void *signaling;
+
+    void const *events;
+
+    std::size_t size;
+
+    bool delivered;
+  };
+
+  template <class R, class M>
+  struct _Bound {
+    R *receiver;
+
+    M method;
+
+    template <class S, class ... As>
+    void operator()(S &signaling, As &&... arguments) const
+    {
+      if constexpr (std::is_invocable<M, R *, S &, As...>::value)
+        (receiver->*method)(signaling, std::forward<As>(arguments)...);
+      else {
+        static_assert(std::is_invocable<M, R *, As...>::value, "");
+
+        (receiver->*method)(std::forward<As>(arguments)...);
+      }
+    }
+  };
+
+  template <class S, class R, auto method, class A>
+  class _Delegate;
+
+  template <class S, class R, auto method, class ... As>
+  class _Delegate<S, R, method, _Arguments<As...>> {
+  public:
+    static bool constexpr VALID =
+      std::is_invocable<decltype(method), R *, S &, As...>::value
+      || std::is_invocable<decltype(method), R *, As...>::value;
+
+    static void invoke(S &signaling, As... arguments, void *data) noexcept
+    {
+      R *receiver = static_cast<R *>(data);
+
+      if constexpr (std::is_invocable<decltype(method), R *, S &, As...>::value)
+        (receiver->*method)(signaling, arguments...);
+      else
+        (receiver->*method)(arguments...);
+    }
+  };
+
+  struct _Tracking {
+    static bool &expiring(void) noexcept
+    {
+      static thread_local bool expiring = false;
+
+      return expiring;
+    }
+  };
+
+  template <class R, class M>
+  struct _Tracked: _Tracking {
+    WeakPtr<R> receiver;
+
+    M method;
+
+    _Tracked(WeakPtr<R> const &receiver, M method) noexcept:
+      receiver(receiver),
+      method(method)
+    {}
+
+    bool expired(void) const noexcept
+    {
+      return receiver.expired();
+    }
+
+    template <class S, class ... As>
+    void operator()(S &signaling, As &&... arguments) const
+    {
+      AutoPtr<R> locked = receiver.lock();
 
-    if (_ms2si.count(signal) == 0UL)
-      _ms2si[signal] = 0U;
+      if (locked == nullptr) {
+        expiring() = true;
 
-    auto isdsi = _ms2dsi.find(signal);
+        return;
+      }
 
-    bool empty = isdsi == _ms2dsi.end() ? true : isdsi->second.empty();
+      _Bound<R, M>{locked, method}(signaling, std::forward<As>(arguments)...);
+    }
+  };
+
+  template <class R, auto method>
+  struct _TrackedDelegate: _Tracking {
+    WeakPtr<R> receiver;
+
+    _TrackedDelegate(WeakPtr<R> const &receiver) noexcept: receiver(receiver) {}
+
+    bool expired(void) const noexcept
+    {
+      return receiver.expired();
+    }
+
+    template <class S, class ... As>
+    void operator()(S &signaling, As &&... arguments) const
+    {
+      AutoPtr<R> locked = receiver.lock();
+
+      if (locked == nullptr) {
+        expiring() = true;
+
+        return;
+      }
+
+      _Bound<R, decltype(method)>{locked, method}(signaling, std::forward<As>(arguments)...);
+    }
+  };
+
+  struct _Connection {
+    Slot0 slot;
+
+    _Manage manage;
+
+    AutoPtr<AtomicRefCounting> attachment;
 
     unsigned subconnectionId;
 
-    if (empty)
-      subconnectionId = _ms2si[signal];
-    else
-      subconnectionId = isdsi->second.front();
+    union {
+      void *data;
+
+      alignas(std::max_align_t) unsigned char storage[_INLINE_SIZE];
+    };
+
+    _Connection(Slot0 slot, void *data, AutoPtr<AtomicRefCounting> attachment) noexcept:
+      slot(slot),
+      manage(nullptr),
+      attachment(std::move(attachment)),
+      subconnectionId(0U),
+      data(data)
+    {}
+
+    _Connection(_Connection const &connection):
+      slot(connection.slot),
+      manage(nullptr),
+      attachment(connection.attachment),
+      subconnectionId(connection.subconnectionId)
+    {
+      assign(connection);
+    }
+
+    _Connection(_Connection &&connection) noexcept:
+      slot(connection.slot),
+      manage(nullptr),
+      attachment(std::move(connection.attachment)),
+      subconnectionId(connection.subconnectionId)
+    {
+      assign(std::move(connection));
+    }
 
-    _ms2msi2sddd[signal].emplace(subconnectionId, TSPVDD(slot, data, detachData));
+    ~_Connection()
+    {
+      if (manage != nullptr)
+        (*manage)(_DESTROY, storage, nullptr);
+    }
 
-    if (empty)
-      ++_ms2si[signal];
-    else
-      isdsi->second.pop_front();
+    _Connection &operator=(_Connection const &connection)
+    {
+      if (&connection != this) {
+        clear();
 
-    return {signal, subconnectionId};
-  }
+        slot = connection.slot;
 
-  void disconnect(MIMUTSPVDD::value_type &smsi2sddd) noexcept
-  {
-    int signal = smsi2sddd.first;
+        attachment = connection.attachment;
 
-    MUTSPVDD &msi2sddd = smsi2sddd.second;
+        subconnectionId = connection.subconnectionId;
 
-    if (msi2sddd.empty())
-      return;
+        assign(connection);
+      }
+
+      return *this;
+    }
 
-    for (auto i = msi2sddd.cbegin(), end = msi2sddd.cend(); i != end; ++i) {
-      TSPVDD const &sddd = i->second;
+    _Connection &operator=(_Connection &&connection) noexcept
+    {
+      if (&connection != this) {
+        clear();
 
-      void *data = std::get<1UL>(sddd);
+        slot = connection.slot;
 
-      DetachData detachData = std::get<2UL>(sddd);
+        attachment = std::move(connection.attachment);
 
-      if (detachData != nullptr)
-        (*detachData)(data);
+        subconnectionId = connection.subconnectionId;
+
+        assign(std::move(connection));
+      }
+
+      return *this;
+    }
+
+    void *context(void) const noexcept
+    {
+      return manage == nullptr ? data : const_cast<unsigned char *>(storage);
     }
 
-    msi2sddd.clear();
+    bool tracked(void) const noexcept
+    {
+      return query(_TRACKED);
+    }
 
-    auto isdsi = _ms2dsi.find(signal);
+    bool expired(void) const noexcept
+    {
+      return query(_EXPIRED);
+    }
 
-    if (isdsi != _ms2dsi.end())
-      isdsi->second.clear();
+    bool deliver(_BatchContext &context) const
+    {
+      context.delivered = false;
 
-    _ms2si[signal] = 0U;
-  }
-};
+      if (manage != nullptr)
+        (*manage)(_BATCH, const_cast<unsigned char *>(storage), &context);
+
+      return context.delivered;
+    }
+
+  private:
+    bool query(_Operation operation) const noexcept
+    {
+      bool result = false;
+
+      if (manage != nullptr)
+        (*manage)(operation, const_cast<unsigned char *>(storage), &result);
+
+      return result;
+    }
+
+    void clear(void) noexcept
+    {
+      if (manage != nullptr)
+        (*manage)(_DESTROY, storage, nullptr);
+
+      manage = nullptr;
+    }
+
+    void assign(_Connection const &connection)
+    {
+      if (connection.manage == nullptr) {
+        data = connection.data;
+
+        return;
+      }
+
+      (*connection.manage)(_COPY, storage, const_cast<unsigned char *>(connection.storage));
+
+      manage = connection.manage;
+    }
+
+    void assign(_Connection &&connection) noexcept
+    {
+      if (connection.manage == nullptr) {
+        data = connection.data;
+
+        return;
+      }
+
+      (*connection.manage)(_MOVE, storage, connection.storage);
+
+      manage = connection.manage;
+    }
+  };
+
+  template <class F>
+  class _Boxed final: public AtomicRefCounting {
+  public:
+    F f;
+
+    template <class FF>
+    _Boxed(FF &&f): f(std::forward<FF>(f)) {}
+
+  private:
+    ~_Boxed() = default;
+  };
+
+  template <class F>
+  struct _Indirect {
+    AutoPtr<_Boxed<F>> boxed;
+
+    template <class ... Ts>
+    auto operator()(Ts &&... values) const
+      -> decltype(std::declval<F &>()(std::forward<Ts>(values)...))
+    {
+      return boxed->f(std::forward<Ts>(values)...);
+    }
+  };
+
+  template <class S, class F, class A>
+  class _Callable;
+
+  template <class S, class F, class ... As>
+  class _Callable<S, F, _Arguments<As...>> {
+  public:
+    typedef std::tuple<typename std::decay<As>::type...> _Event;
+
+    static bool constexpr DIRECT =
+      std::is_invocable<F &, S &, As...>::value || std::is_invocable<F &, As...>::value;
+
+    static bool constexpr BATCHED =
+      !DIRECT
+      && (std::is_invocable<F &, S &, Batch<_Event> const &>::value
+          || std::is_invocable<F &, Batch<_Event> const &>::value);
+
+    static bool constexpr VALID = DIRECT || BATCHED;
+
+    static bool constexpr INLINE =
+      sizeof(F) <= _INLINE_SIZE
+      && alignof(F) <= alignof(std::max_align_t)
+      && std::is_nothrow_move_constructible<F>::value
+      && std::is_copy_constructible<F>::value;
+
+    template <class FF>
+    static _Connection make(FF &&f)
+    {
+      if constexpr (INLINE) {
+        _Connection connection((Slot0)&invoke, nullptr, nullptr);
+
+        new (connection.storage) F(std::forward<FF>(f));
+
+        connection.manage = &manage;
+
+        return connection;
+      } else
+        return _Callable<S, _Indirect<F>, _Arguments<As...>>::make(
+            _Indirect<F>{NEW<_Boxed<F>>(std::forward<FF>(f))});
+    }
+
+  private:
+    static void invoke(S &signaling, As... arguments, void *data) noexcept
+    {
+      F &f = *static_cast<F *>(data);
+
+      if constexpr (std::is_invocable<F &, S &, As...>::value)
+        f(signaling, arguments...);
+      else if constexpr (std::is_invocable<F &, As...>::value)
+        f(arguments...);
+      else {
+        _Event event(arguments...);
+
+        call(f, signaling, Batch<_Event>(&event, 1UL));
+      }
+    }
+
+    static void call(F &f, S &signaling, Batch<_Event> const &batch)
+    {
+      if constexpr (std::is_invocable<F &, S &, Batch<_Event> const &>::value)
+        f(signaling, batch);
+      else
+        f(batch);
+    }
+
+    static void manage(_Operation operation, void *storage, void *storage2)
+    {
+      switch (operation) {
+      case _COPY:
+        new (storage) F(*static_cast<F const *>(storage2));
+
+        break;
+
+      case _MOVE:
+        new (storage) F(std::move(*static_cast<F *>(storage2)));
+
+        break;
+
+      case _DESTROY:
+        static_cast<F *>(storage)->~F();
+
+        break;
+
+      case _TRACKED:
+        *static_cast<bool *>(storage2) = std::is_base_of<_Tracking, F>::value;
+
+        break;
+
+      case _EXPIRED:
+        if constexpr (std::is_base_of<_Tracking, F>::value)
+          *static_cast<bool *>(storage2) = static_cast<F const *>(storage)->expired();
+
+        break;
+
+      case _BATCH:
+        if constexpr (BATCHED) {
+          _BatchContext &context = *static_cast<_BatchContext *>(storage2);
+
+          call(
+              *static_cast<F *>(storage),
+              *static_cast<S *>(context.signaling),
+              Batch<_Event>(static_cast<_Event const *>(context.events), context.size));
+
+          context.delivered = true;
+        }
+
+        break;
+      }
+    }
+  };
+
+  struct _Band {
+    int priority;
+
+    unsigned end;
+  };
+
+  struct _Pending {
+    _Connection connection;
+
+    int priority;
+  };
+
+  struct _Entry {
+    unsigned position;
+
+    unsigned generation;
+  };
+
+  struct _Signal {
+    static unsigned constexpr NONE = ~0U;
+
+    static unsigned constexpr PENDING = 1U << 31;
+
+    SmallVector<_Connection, _INLINE_CONNECTIONS> connections;
+
+    SmallVector<_Entry, _INLINE_CONNECTIONS> si2e;
+
+    unsigned free = NONE;
+
+    SmallVector<_Band, 1UL> bands;
+
+    std::vector<_Pending> pendings;
+
+    unsigned nTrackeds = 0U;
+
+    unsigned nTombstones = 0U;
+
+    mutable unsigned nEmittings = 0U;
+
+    std::pair<unsigned, unsigned> connect(_Connection const &connection, int priority)
+    {
+      if (free == NONE) {
+        si2e.emplace_back(_Entry{NONE, 0U});
+
+        free = static_cast<unsigned>(si2e.size() - 1UL);
+      }
+
+      unsigned subconnectionId = free;
+
+      unsigned next = si2e[subconnectionId].position;
+
+      if (nEmittings != 0U) {
+        pendings.emplace_back(_Pending{connection, priority});
+
+        pendings.back().connection.subconnectionId = subconnectionId;
+
+        si2e[subconnectionId].position =
+          PENDING | static_cast<unsigned>(pendings.size() - 1UL);
+      } else
+        insert(connection, priority, subconnectionId);
+
+      if (connection.tracked())
+        ++nTrackeds;
+
+      free = next;
+
+      return {subconnectionId, ++si2e[subconnectionId].generation};
+    }
+
+    void disconnect(unsigned subconnectionId, unsigned generation)
+    {
+      if ((generation & 1U) == 0U
+          || subconnectionId >= si2e.size()
+          || si2e[subconnectionId].generation != generation)
+        return;
+
+      disconnect(subconnectionId);
+    }
+
+    void disconnect(void) noexcept
+    {
+      if (nEmittings != 0U) {
+        for (auto i = connections.begin(), end = connections.end(); i != end; ++i)
+          if (i->subconnectionId != NONE) {
+            i->subconnectionId = NONE;
+
+            ++nTombstones;
+          }
+      } else {
+        SmallVector<_Connection, _INLINE_CONNECTIONS> connections;
+
+        connections.swap(this->connections);
+
+        bands.clear();
+
+        nTombstones = 0U;
+      }
+
+      std::vector<_Pending> pendings;
+
+      pendings.swap(this->pendings);
+
+      for (unsigned i = 0U, end = static_cast<unsigned>(si2e.size()); i < end; ++i)
+        if ((si2e[i].generation & 1U) != 0U)
+          release(i);
+
+      nTrackeds = 0U;
+    }
+
+    void compact(void)
+    {
+      if (nEmittings != 0U)
+        return;
+
+      for (std::size_t i = connections.size(); i-- > 0UL;)
+        if (connections[i].expired())
+          disconnect(connections[i].subconnectionId);
+    }
+
+    bool unsettled(void) const noexcept
+    {
+      return nTombstones != 0U || !pendings.empty();
+    }
+
+    void settle(void)
+    {
+      if (nEmittings != 0U)
+        return;
+
+      for (unsigned i = static_cast<unsigned>(connections.size()); nTombstones != 0U && i-- > 0U;)
+        if (connections[i].subconnectionId == NONE) {
+          erase(i);
+
+          --nTombstones;
+        }
+
+      std::size_t n = 0UL;
+
+      try {
+        for (std::size_t end = pendings.size(); n < end; ++n) {
+          _Pending const &pending = pendings[n];
+
+          insert(pending.connection, pending.priority, pending.connection.subconnectionId);
+        }
+      } catch (...) {
+        pendings.erase(pendings.begin(), pendings.begin() + n);
+
+        for (std::size_t i = 0UL, end = pendings.size(); i < end; ++i)
+          si2e[pendings[i].connection.subconnectionId].position =
+            PENDING | static_cast<unsigned>(i);
+
+        throw;
+      }
+
+      pendings.clear();
+    }
+
+  private:
+    void disconnect(unsigned subconnectionId)
+    {
+      unsigned position = si2e[subconnectionId].position;
+
+      release(subconnectionId);
+
+      if ((position & PENDING) != 0U) {
+        position &= ~PENDING;
+
+        if (pendings[position].connection.tracked())
+          --nTrackeds;
+
+        _Pending pending = std::move(pendings[position]);
+
+        if (position != pendings.size() - 1UL) {
+          pendings[position] = std::move(pendings.back());
+
+          si2e[pendings[position].connection.subconnectionId].position = PENDING | position;
+        }
+
+        pendings.pop_back();
+
+        return;
+      }
+
+      if (connections[position].tracked())
+        --nTrackeds;
+
+      if (nEmittings != 0U) {
+        connections[position].subconnectionId = NONE;
+
+        ++nTombstones;
+
+        return;
+      }
+
+      erase(position);
+    }
+
+    void release(unsigned subconnectionId) noexcept
+    {
+      _Entry &entry = si2e[subconnectionId];
+
+      entry.position = free;
+
+      ++entry.generation;
+
+      free = subconnectionId;
+    }
+
+    void insert(_Connection const &connection, int priority, unsigned subconnectionId)
+    {
+      std::size_t band = 0UL;
+
+      while (band < bands.size() && bands[band].priority > priority)
+        ++band;
+
+      connections.emplace_back(connection);
+
+      if (band == bands.size() || bands[band].priority != priority) {
+        unsigned end = band == 0UL ? 0U : bands[band - 1UL].end;
+
+        try {
+          bands.emplace(bands.begin() + band, _Band{priority, end});
+        } catch (...) {
+          connections.pop_back();
+
+          throw;
+        }
+      }
+
+      unsigned position = static_cast<unsigned>(connections.size() - 1UL);
+
+      for (std::size_t i = bands.size() - 1UL; i > band; --i) {
+        unsigned begin = bands[i - 1UL].end;
+
+        if (begin != position) {
+          std::swap(connections[begin], connections[position]);
+
+          if (connections[position].subconnectionId != NONE)
+            si2e[connections[position].subconnectionId].position = position;
+        }
+
+        ++bands[i].end;
+
+        position = begin;
+      }
+
+      ++bands[band].end;
+
+      connections[position].subconnectionId = subconnectionId;
+
+      si2e[subconnectionId].position = position;
+    }
+
+    void erase(unsigned position)
+    {
+      _Connection connection = std::move(connections[position]);
+
+      std::size_t band = 0UL;
+
+      while (bands[band].end <= position)
+        ++band;
+
+      for (std::size_t i = band; i < bands.size(); ++i) {
+        unsigned last = --bands[i].end;
+
+        if (last != position) {
+          connections[position] = std::move(connections[last]);
+
+          if (connections[position].subconnectionId != NONE)
+            si2e[connections[position].subconnectionId].position = position;
+        }
+
+        position = last;
+      }
+
+      connections.pop_back();
+
+      if (bands[band].end == (band == 0UL ? 0U : bands[band - 1UL].end))
+        bands.erase(bands.begin() + band);
+    }
+  };
+
+  class _Table final: public AtomicRefCounting {
+  public:
+    bool const concurrent;
+
+    std::vector<_Signal> signals;
+
+    _Table(bool concurrent) noexcept: concurrent(concurrent) {}
+
+    _Table(_Table const &table): concurrent(table.concurrent), signals(table.signals)
+    {
+      for (auto i = signals.begin(), end = signals.end(); i != end; ++i) {
+        i->nEmittings = 0U;
+
+        i->settle();
+      }
+    }
+
+    bool shared(unsigned nBorrowings = 0U) const noexcept
+    {
+      return count() > 1U + nBorrowings;
+    }
+
+    bool emitting(void) const noexcept
+    {
+      for (auto i = signals.begin(), end = signals.end(); i != end; ++i)
+        if (i->nEmittings != 0U)
+          return true;
+
+      return false;
+    }
+
+  private:
+    ~_Table() = default;
+  };
+
+  AtomicAutoPtr<_Table> _table;
+
+  static AutoPtr<AtomicRefCounting> attach(void *data, DetachData detachData)
+  {
+    if (detachData == nullptr)
+      return nullptr;
+
+    return NEW<_Detachment>(data, detachData);
+  }
+
+  static AutoPtr<_Table> share(Signaling const &signaling)
+  {
+    AutoPtr<_Table> table = signaling._table.load();
+
+    if (table == nullptr || table->concurrent || !table->emitting())
+      return table;
+
+    return NEW<_Table>(*table);
+  }
+
+  template <class F>
+  void update(F f, std::size_t count = 0UL, bool concurrent = false)
+  {
+    AutoPtr<_Table> table = _table.load();
+
+    if (table == nullptr && count == 0UL)
+      return;
+
+    if (table != nullptr
+        && !table->concurrent
+        && !table->shared(1U)
+        && (table->signals.size() >= count || !table->emitting())) {
+      if (table->signals.size() < count)
+        table->signals.resize(count);
+
+      f(*table);
+
+      return;
+    }
+
+    for (;;) {
+      AutoPtr<_Table> copy = table == nullptr ? NEW<_Table>(concurrent) : NEW<_Table>(*table);
+
+      if (copy->signals.size() < count)
+        copy->signals.resize(count);
+
+      f(*copy);
+
+      if (_table.compareExchange(table, std::move(copy))) {
+        // Growing a table in the middle of an exclusive emission would move the signal it walks,
+        // so the table is replaced instead and kept alive until the outermost emission returns.
+        if (table != nullptr && !table->concurrent && table->emitting())
+          table->ref();
+
+        return;
+      }
+    }
+  }
+
+  template <bool concurrent>
+  bool observed(int signal) const noexcept
+  {
+    _Table const *table = _table.peek();
+
+    if (table == nullptr)
+      return false;
+
+    if (concurrent)
+      return true;
+
+    if (static_cast<std::size_t>(signal) >= table->signals.size())
+      return false;
+
+    _Signal const &signal_ = table->signals[signal];
+
+    return !signal_.connections.empty() || !signal_.pendings.empty();
+  }
+
+  template <bool concurrent, class F>
+  void each(int signal, F f) noexcept
+  {
+    _Table const *table = _table.peek();
+
+    if (table == nullptr)
+      return;
+
+    AutoPtr<_Table> snapshot;
+
+    if (concurrent || table->shared()) {
+      snapshot = _table.load();
+
+      table = snapshot;
+
+      if (table == nullptr)
+        return;
+    }
+
+    if (static_cast<std::size_t>(signal) >= table->signals.size())
+      return;
+
+    _Signal const &signal_ = table->signals[signal];
+
+    SmallVector<_Connection, _INLINE_CONNECTIONS> const &connections = signal_.connections;
+
+    bool tracking = signal_.nTrackeds != 0U;
+
+    bool expiring = tracking && std::exchange(_Tracking::expiring(), false);
+
+    bool exclusive = snapshot == nullptr;
+
+    if (exclusive)
+      ++signal_.nEmittings;
+
+    for (auto i = connections.cbegin(), end = connections.cend(); i != end; ++i)
+      if (i->subconnectionId != _Signal::NONE
+          && (concurrent || (exclusive && _table.peek() == table) || live(signal, signal_, *i)))
+        f(*i);
+
+    if (exclusive && --signal_.nEmittings == 0U) {
+      if (_table.peek() != table) {
+        if (!table->emitting())
+          table->deref();
+      } else if (signal_.unsettled())
+        settle(signal);
+    }
+
+    if (tracking && std::exchange(_Tracking::expiring(), expiring))
+      compact(signal);
+  }
+
+  bool live(int signal, _Signal const &snapshot, _Connection const &connection) const noexcept
+  {
+    _Table const *table = _table.peek();
+
+    if (table == nullptr || static_cast<std::size_t>(signal) >= table->signals.size())
+      return false;
+
+    _Signal const &signal_ = table->signals[signal];
+
+    if (&signal_ == &snapshot)
+      return true;
+
+    unsigned subconnectionId = connection.subconnectionId;
+
+    return subconnectionId < signal_.si2e.size()
+      && signal_.si2e[subconnectionId].generation == snapshot.si2e[subconnectionId].generation;
+  }
+
+  void settle(int signal) noexcept
+  {
+    try {
+      update([&] (_Table &table) {
+        table.signals[signal].settle();
+      });
+    } catch (...) {}
+  }
+
+  void compact(int signal) noexcept
+  {
+    try {
+      update([&] (_Table &table) {
+        table.signals[signal].compact();
+      });
+    } catch (...) {}
+  }
+
+  template <int signal, class S, class ... AsD>
+  static _Connection make(
+      S *self,
+      Slot2<S, AsD...> slot,
+      void *data,
+      DetachData detachData = nullptr)
+  {
+    typedef typename SIGNALIZE<S, signal>::SIGNATURE _SIGNATURE;
+
+    static_assert(IsInstanceOfSIGNATURE<_SIGNATURE>::value, "");
+
+    static_assert(std::is_same<Slot2<S, AsD...>, typename _SIGNATURE::template SLOT<S>>::value, "");
+
+    if (slot == nullptr)
+      throw std::runtime_error("");
+
+    return _Connection((Slot0)slot, data, attach(data, detachData));
+  }
+
+  template <int signal, class S, class ... As>
+  static _Connection make(S *self, Slot2<S, As...> slot)
+  {
+    typedef typename SIGNALIZE<S, signal>::SIGNATURE _SIGNATURE;
+
+    static_assert(IsInstanceOfSIGNATURE<_SIGNATURE>::value, "");
+
+    static_assert(std::is_same<Slot2<S, As...>, typename _SIGNATURE::template SLOT<S>>::value, "");
+
+    if (slot == nullptr)
+      throw std::runtime_error("");
+
+    return _Connection((Slot0)slot, nullptr, nullptr);
+  }
+
+  // Queued and coalesced slots run on the executor after emit has returned, so the sender has to
+  // stay alive until then. A sender derived from AtomicRefCounting or BiasedRefCounting is pinned
+  // by a strong reference for every pending delivery. Other reference-counted senders are rejected,
+  // since their counts must not be touched from the executor's threads. A sender that is not
+  // reference counted must outlive every delivery it has queued. Each delivery is posted as an
+  // Executor::Task, so arguments that do not fit its inline buffer cost an allocation per emit.
+  template <int signal, class S, class ... AsD>
+  static _Connection make(
+      S *self,
+      Executor &executor,
+      Slot2<S, AsD...> slot,
+      void *data,
+      DetachData detachData = nullptr)
+  {
+    typedef typename SIGNALIZE<S, signal>::SIGNATURE _SIGNATURE;
+
+    static_assert(IsInstanceOfSIGNATURE<_SIGNATURE>::value, "");
+
+    static_assert(std::is_same<Slot2<S, AsD...>, typename _SIGNATURE::template SLOT<S>>::value, "");
+
+    typedef _Queued<S, typename _SIGNATURE::ARGUMENTS> _Queued_;
+
+    if (slot == nullptr)
+      throw std::runtime_error("");
+
+    AutoPtr<_Queued_> queued = NEW<_Queued_>(executor, slot, data, attach(data, detachData));
+
+    return _Connection((Slot0)&_Queued_::queue, static_cast<_Queued_ *>(queued), queued);
+  }
+
+  template <int signal, class S, class ... As>
+  static _Connection make(S *self, Executor &executor, Slot2<S, As...> slot)
+  {
+    return make<signal>(self, executor, slot, nullptr, nullptr);
+  }
+
+  template <int signal, class S, class ... AsD>
+  static _Connection make(
+      S *self,
+      Executor &executor,
+      Coalescing const &coalescing,
+      Slot2<S, AsD...> slot,
+      void *data,
+      DetachData detachData = nullptr)
+  {
+    typedef typename SIGNALIZE<S, signal>::SIGNATURE _SIGNATURE;
+
+    static_assert(IsInstanceOfSIGNATURE<_SIGNATURE>::value, "");
+
+    static_assert(std::is_same<Slot2<S, AsD...>, typename _SIGNATURE::template SLOT<S>>::value, "");
+
+    typedef _Coalesced<S, typename _SIGNATURE::ARGUMENTS> _Coalesced_;
+
+    if (slot == nullptr)
+      throw std::runtime_error("");
+
+    AutoPtr<_Coalesced_> coalesced =
+      NEW<_Coalesced_>(executor, coalescing, slot, data, attach(data, detachData));
+
+    return _Connection(
+        (Slot0)&_Coalesced_::queue,
+        static_cast<_Coalesced_ *>(coalesced),
+        coalesced);
+  }
+
+  template <int signal, class S, class ... As>
+  static _Connection make(
+      S *self,
+      Executor &executor,
+      Coalescing const &coalescing,
+      Slot2<S, As...> slot)
+  {
+    return make<signal>(self, executor, coalescing, slot, nullptr, nullptr);
+  }
+
+  template <int signal, class S, class F, EIINFPVIT<F> = 0>
+  static _Connection make(S *self, F &&f)
+  {
+    typedef typename SIGNALIZE<S, signal>::SIGNATURE _SIGNATURE;
+
+    static_assert(IsInstanceOfSIGNATURE<_SIGNATURE>::value, "");
+
+    typedef _Callable<S, typename std::decay<F>::type, typename _SIGNATURE::ARGUMENTS> _Callable_;
+
+    static_assert(_Callable_::VALID, "");
+
+    return _Callable_::make(std::forward<F>(f));
+  }
+
+  template <int signal, class S, class M, class R, EIIMFPVIT<M> = 0>
+  static _Connection make(S *self, M method, R *receiver)
+  {
+    if (method == nullptr || receiver == nullptr)
+      throw std::runtime_error("");
+
+    return make<signal>(self, _Bound<R, M>{receiver, method});
+  }
+
+  template <int signal, auto method, class S, class R>
+  static _Connection make(S *self, R *receiver)
+  {
+    static_assert(std::is_member_function_pointer<decltype(method)>::value, "");
+
+    typedef typename SIGNALIZE<S, signal>::SIGNATURE _SIGNATURE;
+
+    static_assert(IsInstanceOfSIGNATURE<_SIGNATURE>::value, "");
+
+    typedef _Delegate<S, R, method, typename _SIGNATURE::ARGUMENTS> _Delegate_;
+
+    static_assert(_Delegate_::VALID, "");
+
+    if (receiver == nullptr)
+      throw std::runtime_error("");
+
+    return _Connection(
+        (Slot0)&_Delegate_::invoke,
+        const_cast<void *>(static_cast<void const *>(receiver)),
+        nullptr);
+  }
+
+  template <int signal, class S, class M, class R, EIIMFPVIT<M> = 0>
+  static _Connection make(S *self, M method, WeakPtr<R> const &receiver)
+  {
+    static_assert(!_CONCURRENT<S>::value, "");
+
+    if (method == nullptr || receiver.expired())
+      throw std::runtime_error("");
+
+    return make<signal>(self, _Tracked<R, M>(receiver, method));
+  }
+
+  template <int signal, auto method, class S, class R>
+  static _Connection make(S *self, WeakPtr<R> const &receiver)
+  {
+    static_assert(!_CONCURRENT<S>::value, "");
+
+    static_assert(std::is_member_function_pointer<decltype(method)>::value, "");
+
+    if (receiver.expired())
+      throw std::runtime_error("");
+
+    return make<signal>(self, _TrackedDelegate<R, method>(receiver));
+  }
+
+
+  ConnectionId connect(
+      int signal,
+      int count,
+      bool concurrent,
+      _Connection const &connection,
+      int priority)
+  {
+    std::pair<unsigned, unsigned> handle;
+
+    update(
+        [&] (_Table &table) {
+          handle = table.signals[signal].connect(connection, priority);
+        },
+        count,
+        concurrent);
+
+    return {signal, handle.first, handle.second};
+  }
+};
+
+static_assert(sizeof(Signaling) == sizeof(void *), "");
 
 #endif
@@ -0,0 +1,336 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Kevin XU <kevin.xu.1982.02.06@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *
+ *
+ * Author: Kevin XU <kevin.xu.1982.02.06@gmail.com>
+ *
+ */
+
+#ifndef __SMALL_VECTOR_HPP
+# define __SMALL_VECTOR_HPP
+
+# include <cstddef>
+
+# include <algorithm>
+# include <new>
+# include <type_traits>
+# include <utility>
+
+
+
+template <class T, std::size_t N>
+class SmallVector {
+  static_assert(N >= 1UL, "");
+
+  static_assert(std::is_nothrow_move_constructible<T>::value, "");
+
+  static_assert(std::is_nothrow_move_assignable<T>::value, "");
+
+  static_assert(alignof(T) <= alignof(std::max_align_t), "");
+public:
+  SmallVector(void) noexcept: _data(inlineData()), _size(0UL), _capacity(N) {}
+
+  SmallVector(SmallVector const &smallVector): SmallVector()
+  {
+    reserve(smallVector._size);
+
+    for (std::size_t i = 0UL; i < smallVector._size; ++i)
+      emplace_back(smallVector._data[i]);
+  }
+
+  SmallVector(SmallVector &&smallVector) noexcept: SmallVector()
+  {
+    take(smallVector);
+  }
+
+  ~SmallVector()
+  {
+    clear();
+
+    release();
+  }
+
+  SmallVector &operator=(SmallVector const &smallVector)
+  {
+    if (&smallVector != this) {
+      SmallVector copy(smallVector);
+
+      swap(copy);
+    }
+
+    return *this;
+  }
+
+  SmallVector &operator=(SmallVector &&smallVector) noexcept
+  {
+    if (&smallVector != this) {
+      clear();
+
+      release();
+
+      take(smallVector);
+    }
+
+    return *this;
+  }
+
+  T *begin(void) noexcept
+  {
+    return _data;
+  }
+
+  T const *begin(void) const noexcept
+  {
+    return _data;
+  }
+
+  T const *cbegin(void) const noexcept
+  {
+    return _data;
+  }
+
+  T *end(void) noexcept
+  {
+    return _data + _size;
+  }
+
+  T const *end(void) const noexcept
+  {
+    return _data + _size;
+  }
+
+  T const *cend(void) const noexcept
+  {
+    return _data + _size;
+  }
+
+  std::size_t size(void) const noexcept
+  {
+    return _size;
+  }
+
+  bool empty(void) const noexcept
+  {
+    return _size == 0UL;
+  }
+
+  std::size_t capacity(void) const noexcept
+  {
+    return _capacity;
+  }
+
+  bool inlined(void) const noexcept
+  {
+    return _data == inlineData();
+  }
+
+  T &operator[](std::size_t index) noexcept
+  {
+    return _data[index];
+  }
+
+  T const &operator[](std::size_t index) const noexcept
+  {
+    return _data[index];
+  }
+
+  T &back(void) noexcept
+  {
+    return _data[_size - 1UL];
+  }
+
+  T const &back(void) const noexcept
+  {
+    return _data[_size - 1UL];
+  }
+
+  void reserve(std::size_t capacity)
+  {
+    if (capacity > _capacity)
+      reallocate(capacity);
+  }
+
+  template <class ... Ts>
+  T &emplace_back(Ts &&... values)
+  {
+    if (_size < _capacity)
+      new (_data + _size) T(std::forward<Ts>(values)...);
+    else {
+      std::size_t capacity = 2UL * _capacity;
+
+      T *data = static_cast<T *>(::operator new(capacity * sizeof(T)));
+
+      try {
+        new (data + _size) T(std::forward<Ts>(values)...);
+      } catch (...) {
+        ::operator delete(data);
+
+        throw;
+      }
+
+      adopt(data, capacity);
+    }
+
+    return _data[_size++];
+  }
+
+  template <class ... Ts>
+  T *emplace(T const *position, Ts &&... values)
+  {
+    std::size_t index = position - _data;
+
+    if (index == _size) {
+      emplace_back(std::forward<Ts>(values)...);
+
+      return _data + index;
+    }
+
+    T value(std::forward<Ts>(values)...);
+
+    emplace_back(std::move(_data[_size - 1UL]));
+
+    std::move_backward(_data + index, _data + _size - 2UL, _data + _size - 1UL);
+
+    _data[index] = std::move(value);
+
+    return _data + index;
+  }
+
+  T *erase(T const *position) noexcept
+  {
+    return erase(position, position + 1);
+  }
+
+  T *erase(T const *first, T const *last) noexcept
+  {
+    T *begin = _data + (first - _data);
+
+    T *end = _data + (last - _data);
+
+    if (begin != end) {
+      T *newEnd = std::move(end, _data + _size, begin);
+
+      for (T *i = newEnd; i != _data + _size; ++i)
+        i->~T();
+
+      _size = newEnd - _data;
+    }
+
+    return begin;
+  }
+
+  void pop_back(void) noexcept
+  {
+    _data[--_size].~T();
+  }
+
+  void clear(void) noexcept
+  {
+    while (_size != 0UL)
+      pop_back();
+  }
+
+  void swap(SmallVector &smallVector) noexcept
+  {
+    SmallVector temporary(std::move(smallVector));
+
+    smallVector = std::move(*this);
+
+    *this = std::move(temporary);
+  }
+
+private:
+  T *_data;
+
+  std::size_t _size;
+
+  std::size_t _capacity;
+
+  alignas(T) unsigned char _storage[N * sizeof(T)];
+
+  T *inlineData(void) noexcept
+  {
+    return reinterpret_cast<T *>(_storage);
+  }
+
+  T const *inlineData(void) const noexcept
+  {
+    return reinterpret_cast<T const *>(_storage);
+  }
+
+  void reallocate(std::size_t capacity)
+  {
+    adopt(static_cast<T *>(::operator new(capacity * sizeof(T))), capacity);
+  }
+
+  void adopt(T *data, std::size_t capacity) noexcept
+  {
+    for (std::size_t i = 0UL; i < _size; ++i) {
+      new (data + i) T(std::move(_data[i]));
+
+      _data[i].~T();
+    }
+
+    release();
+
+    _data = data;
+
+    _capacity = capacity;
+  }
+
+  void release(void) noexcept
+  {
+    if (!inlined())
+      ::operator delete(_data);
+
+    _data = inlineData();
+
+    _capacity = N;
+  }
+
+  void take(SmallVector &smallVector) noexcept
+  {
+    if (smallVector.inlined()) {
+      for (std::size_t i = 0UL; i < smallVector._size; ++i)
+        new (_data + i) T(std::move(smallVector._data[i]));
+
+      _size = smallVector._size;
+
+      smallVector.clear();
+
+      return;
+    }
+
+    _data = smallVector._data;
+
+    _size = smallVector._size;
+
+    _capacity = smallVector._capacity;
+
+    smallVector._data = smallVector.inlineData();
+
+    smallVector._size = 0UL;
+
+    smallVector._capacity = N;
+  }
+};
+
+#endif
@@ -0,0 +1,233 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Kevin XU <kevin.xu.1982.02.06@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *
+ *
+ * Author: Kevin XU <kevin.xu.1982.02.06@gmail.com>
+ *
+ */
+
+#ifndef __THREAD_POOL_HPP
+# define __THREAD_POOL_HPP
+
+# include <cstddef>
+
+# include <algorithm>
+# include <atomic>
+# include <chrono>
+# include <condition_variable>
+# include <functional>
+# include <mutex>
+# include <thread>
+# include <utility>
+# include <vector>
+
+# include "bounded-queue.hpp"
+# include "executor.hpp"
+
+
+
+class ThreadPool final: public Executor {
+public:
+  ThreadPool(unsigned nThreads, std::size_t capacity = 1024UL):
+    _queue(capacity),
+    _nTimers(0UL),
+    _sequence(0UL),
+    _nSleepings(0U),
+    _stopping(false)
+  {
+    if (nThreads == 0U)
+      nThreads = 1U;
+
+    _threads.reserve(nThreads);
+
+    for (unsigned i = 0U; i < nThreads; ++i)
+      _threads.emplace_back(&ThreadPool::run, this);
+  }
+
+  ~ThreadPool()
+  {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+
+      _stopping = true;
+    }
+
+    _condition.notify_all();
+
+    for (auto i = _threads.begin(), end = _threads.end(); i != end; ++i)
+      i->join();
+  }
+
+  void post(Task task) override
+  {
+    while (!_queue.tryPush(std::move(task))) {
+      if (_current == this) {
+        task();
+
+        return;
+      }
+
+      std::this_thread::yield();
+    }
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (_nSleepings.load(std::memory_order_relaxed) == 0U)
+      return;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    _condition.notify_one();
+  }
+
+  void post(Task task, Clock::time_point time) override
+  {
+    if (time <= Clock::now()) {
+      post(std::move(task));
+
+      return;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+
+      _timers.emplace_back(_Timer{time, _sequence++, std::move(task)});
+
+      std::push_heap(_timers.begin(), _timers.end(), std::greater<_Timer>());
+
+      _nTimers.store(_timers.size(), std::memory_order_relaxed);
+    }
+
+    _condition.notify_one();
+  }
+
+private:
+  struct _Timer {
+    Clock::time_point time;
+
+    std::size_t sequence;
+
+    Task task;
+
+    friend bool operator>(_Timer const &lhs, _Timer const &rhs) noexcept
+    {
+      return lhs.time > rhs.time || (lhs.time == rhs.time && lhs.sequence > rhs.sequence);
+    }
+  };
+
+  static inline thread_local ThreadPool *_current = nullptr;
+
+  BoundedQueue<Task> _queue;
+
+  std::vector<_Timer> _timers;
+
+  std::atomic<std::size_t> _nTimers;
+
+  std::size_t _sequence;
+
+  std::vector<std::thread> _threads;
+
+  std::mutex _mutex;
+
+  std::condition_variable _condition;
+
+  std::atomic<unsigned> _nSleepings;
+
+  bool _stopping;
+
+  void run(void)
+  {
+    _current = this;
+
+    Task task;
+
+    for (;;) {
+      if (_nTimers.load(std::memory_order_relaxed) != 0UL && popDueTimer(task)) {
+        task();
+
+        task = nullptr;
+
+        continue;
+      }
+
+      if (_queue.tryPop(task)) {
+        task();
+
+        task = nullptr;
+
+        continue;
+      }
+
+      std::unique_lock<std::mutex> lock(_mutex);
+
+      _nSleepings.fetch_add(1U, std::memory_order_relaxed);
+
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+
+      if (_queue.tryPop(task)) {
+        _nSleepings.fetch_sub(1U, std::memory_order_relaxed);
+
+        lock.unlock();
+
+        task();
+
+        task = nullptr;
+
+        continue;
+      }
+
+      if (_stopping) {
+        _nSleepings.fetch_sub(1U, std::memory_order_relaxed);
+
+        break;
+      }
+
+      if (_timers.empty())
+        _condition.wait(lock);
+      else
+        _condition.wait_until(lock, _timers.front().time);
+
+      _nSleepings.fetch_sub(1U, std::memory_order_relaxed);
+    }
+
+    _current = nullptr;
+  }
+
+  bool popDueTimer(Task &task)
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_timers.empty() || _timers.front().time > Clock::now())
+      return false;
+
+    std::pop_heap(_timers.begin(), _timers.end(), std::greater<_Timer>());
+
+    task = std::move(_timers.back().task);
+
+    _timers.pop_back();
+
+    _nTimers.store(_timers.size(), std::memory_order_relaxed);
+
+    return true;
+  }
+};
+
+#endif
@@ -0,0 +1,230 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Kevin XU <kevin.xu.1982.02.06@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *
+ *
+ * Author: Kevin XU <kevin.xu.1982.02.06@gmail.com>
+ *
+ */
+
+#ifndef __WEAK_PTR_HPP
+# define __WEAK_PTR_HPP
+
+# include <cstddef>
+
+# include <type_traits>
+
+# include "auto-ptr.hpp"
+# include "ref-counting.hpp"
+
+
+
+class WeakRefCounting: public RefCounting {
+protected:
+  WeakRefCounting(void) noexcept: _link(nullptr) {}
+
+  ~WeakRefCounting()
+  {
+    if (_link != nullptr)
+      _link->pointer = nullptr;
+  }
+
+private:
+  class Link: public RefCounting {
+  public:
+    WeakRefCounting const *pointer;
+
+    Link(WeakRefCounting const *pointer) noexcept: pointer(pointer) {}
+
+  protected:
+    ~Link() = default;
+  };
+
+  mutable AutoPtr<Link> _link;
+
+  AutoPtr<Link> const &link(void) const
+  {
+    if (_link == nullptr)
+      _link = NEW<Link>(this);
+
+    return _link;
+  }
+
+  bool expired(void) const noexcept
+  {
+    return count() == 0U;
+  }
+
+  template <class RC>
+  friend class WeakPtr;
+};
+
+template <class RC>
+class WeakPtr {
+  static_assert(RefCounting::CHECK<RC>::value, "");
+
+  static_assert(std::is_base_of<WeakRefCounting, RC>::value, "");
+public:
+  typedef RC ContentType;
+
+  template <class F, class T>
+  using EIICPFPTVIT = typename std::enable_if<std::is_convertible<F *, T *>::value, int>::type;
+
+  constexpr WeakPtr(void) noexcept: _pointer(nullptr), _link() {}
+
+  constexpr WeakPtr(std::nullptr_t) noexcept: _pointer(nullptr), _link() {}
+
+  WeakPtr(RC *pointer)
+  {
+    set(pointer);
+  }
+
+  template <class RRC, EIICPFPTVIT<RRC, RC> = 0>
+  WeakPtr(AutoPtr<RRC> const &autoPtr)
+  {
+    set(autoPtr);
+  }
+
+  WeakPtr(WeakPtr const &weakPtr) = default;
+
+  template <class RRC, EIICPFPTVIT<RRC, RC> = 0>
+  WeakPtr(WeakPtr<RRC> const &weakPtr) noexcept: _pointer(weakPtr._pointer), _link(weakPtr._link)
+  {}
+
+  WeakPtr(WeakPtr &&weakPtr) noexcept: _pointer(weakPtr._pointer), _link(std::move(weakPtr._link))
+  {
+    weakPtr._pointer = nullptr;
+  }
+
+  template <class RRC, EIICPFPTVIT<RRC, RC> = 0>
+  WeakPtr(WeakPtr<RRC> &&weakPtr) noexcept:
+    _pointer(weakPtr._pointer),
+    _link(std::move(weakPtr._link))
+  {
+    weakPtr._pointer = nullptr;
+  }
+
+  ~WeakPtr() = default;
+
+  WeakPtr &operator=(std::nullptr_t)
+  {
+    _pointer = nullptr;
+
+    _link = nullptr;
+
+    return *this;
+  }
+
+  WeakPtr &operator=(RC *pointer)
+  {
+    set(pointer);
+
+    return *this;
+  }
+
+  template <class RRC, EIICPFPTVIT<RRC, RC> = 0>
+  WeakPtr &operator=(AutoPtr<RRC> const &autoPtr)
+  {
+    set(autoPtr);
+
+    return *this;
+  }
+
+  WeakPtr &operator=(WeakPtr const &weakPtr) = default;
+
+  template <class RRC, EIICPFPTVIT<RRC, RC> = 0>
+  WeakPtr &operator=(WeakPtr<RRC> const &weakPtr)
+  {
+    _pointer = weakPtr._pointer;
+
+    _link = weakPtr._link;
+
+    return *this;
+  }
+
+  WeakPtr &operator=(WeakPtr &&weakPtr)
+  {
+    move(weakPtr);
+
+    return *this;
+  }
+
+  template <class RRC, EIICPFPTVIT<RRC, RC> = 0>
+  WeakPtr &operator=(WeakPtr<RRC> &&weakPtr)
+  {
+    move(weakPtr);
+
+    return *this;
+  }
+
+  AutoPtr<RC> lock(void) const
+  {
+    if (expired())
+      return nullptr;
+
+    return _pointer;
+  }
+
+  bool expired(void) const noexcept
+  {
+    if (_link == nullptr)
+      return true;
+
+    WeakRefCounting const *pointer = _link->pointer;
+
+    return pointer == nullptr || pointer->expired();
+  }
+
+  void swap(WeakPtr &weakPtr) noexcept
+  {
+    RC *pointer = _pointer;
+
+    _pointer = weakPtr._pointer;
+
+    weakPtr._pointer = pointer;
+
+    _link.swap(weakPtr._link);
+  }
+
+private:
+  RC *_pointer;
+
+  AutoPtr<WeakRefCounting::Link> _link;
+
+  void set(RC *pointer)
+  {
+    _link = pointer == nullptr ? nullptr : pointer->link();
+
+    _pointer = pointer;
+  }
+
+  template <class RRC>
+  void move(WeakPtr<RRC> &weakPtr)
+  {
+    _link = std::move(weakPtr._link), weakPtr._link = nullptr;
+
+    _pointer = weakPtr._pointer, weakPtr._pointer = nullptr;
+  }
+
+  template <class RC_>
+  friend class WeakPtr;
+};
+
+#endif
@@ -58,7 +58,7 @@ private:
   {
     _types.clear();
 
-    _values.flush();
+    _values.str(::std::string());
 
     saveArguments0(arguments...);
   }
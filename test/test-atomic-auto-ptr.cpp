@@ -0,0 +1,162 @@
+/*
+ *
+ * Author: Kevin XU <kevin.xu.1982.02.06@gmail.com>
+ *
+ */
+
+#include <cassert>
+#include <cstdlib>
+
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../include/atomic-auto-ptr.hpp"
+#include "../include/auto-ptr.hpp"
+
+#include "rand.hpp"
+
+
+#define _RAND_MAX 1024
+
+#define _N_THREADS 4
+
+#define _MAGIC 0x5A5A5A5A
+
+
+
+using namespace std;
+
+using namespace Test;
+
+static atomic<int> _nLives(0);
+
+class _TestAtomicAutoPtr: public AtomicRefCounting {
+public:
+  _TestAtomicAutoPtr(int value) noexcept: _magic(_MAGIC), _value(value)
+  {
+    ++_nLives;
+  }
+
+  int value(void) const noexcept
+  {
+    assert(_magic == _MAGIC);
+
+    return _value;
+  }
+
+protected:
+  ~_TestAtomicAutoPtr() noexcept
+  {
+    assert(_magic == _MAGIC);
+
+    _magic = 0;
+
+    --_nLives;
+  }
+
+private:
+  int _magic;
+
+  int const _value;
+};
+
+static void _read(AtomicAutoPtr<_TestAtomicAutoPtr> const *atomicAutoPtr, int n) noexcept
+{
+  for (int i = 0; i < n; ++i) {
+    AutoPtr<_TestAtomicAutoPtr> autoPtr = atomicAutoPtr->load();
+
+    assert(!!autoPtr);
+
+    assert(autoPtr->value() >= 0);
+  }
+}
+
+static void _write(AtomicAutoPtr<_TestAtomicAutoPtr> *atomicAutoPtr, int n) noexcept
+{
+  for (int i = 0; i < n; ++i)
+    if (i % 2 == 0)
+      atomicAutoPtr->store(NEW<_TestAtomicAutoPtr>(i));
+    else {
+      AutoPtr<_TestAtomicAutoPtr> expected = atomicAutoPtr->load();
+
+      while (!atomicAutoPtr->compareExchange(expected, NEW<_TestAtomicAutoPtr>(i)))
+        assert(!!expected);
+    }
+}
+
+int main(int argc, char const *argv[])
+{
+  {
+    AtomicAutoPtr<_TestAtomicAutoPtr> atomicAutoPtr;
+
+    assert(!atomicAutoPtr.load());
+
+    AutoPtr<_TestAtomicAutoPtr> autoPtr = NEW<_TestAtomicAutoPtr>(1);
+
+    atomicAutoPtr.store(autoPtr);
+
+    assert(atomicAutoPtr.load() == autoPtr);
+
+    assert(atomicAutoPtr.peek() == autoPtr);
+
+    assert(_nLives == 1);
+
+    AutoPtr<_TestAtomicAutoPtr> expected = NEW<_TestAtomicAutoPtr>(2);
+
+    assert(!atomicAutoPtr.compareExchange(expected, NEW<_TestAtomicAutoPtr>(3)));
+
+    assert(expected == autoPtr);
+
+    assert(_nLives == 1);
+
+    assert(atomicAutoPtr.compareExchange(expected, NEW<_TestAtomicAutoPtr>(4)));
+
+    assert(atomicAutoPtr.load()->value() == 4);
+
+    assert(_nLives == 2);
+
+    AutoPtr<_TestAtomicAutoPtr> old = atomicAutoPtr.exchange(nullptr);
+
+    assert(old->value() == 4);
+
+    assert(!atomicAutoPtr.load());
+
+    old = nullptr;
+
+    expected = nullptr;
+
+    autoPtr = nullptr;
+
+    assert(_nLives == 0);
+
+    atomicAutoPtr = NEW<_TestAtomicAutoPtr>(5);
+  }
+
+  assert(_nLives == 0);
+
+  {
+    AtomicAutoPtr<_TestAtomicAutoPtr> atomicAutoPtr(NEW<_TestAtomicAutoPtr>(0));
+
+    vector<thread> threads;
+
+    for (int i = 0; i < _N_THREADS; ++i)
+      threads.emplace_back(&_read, &atomicAutoPtr, (rand(_RAND_MAX) + 1) * _RAND_MAX);
+
+    for (int i = 0; i < _N_THREADS; ++i)
+      threads.emplace_back(&_write, &atomicAutoPtr, (rand(_RAND_MAX) + 1) * 16);
+
+    for (auto i = threads.begin(), end = threads.end(); i != end; ++i)
+      i->join();
+
+    assert(_nLives == 1);
+  }
+
+  assert(_nLives == 0);
+
+  cout << "\"test-atomic-auto-ptr\" passed." << endl;
+
+  return 0;
+}
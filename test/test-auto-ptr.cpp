@@ -7,6 +7,7 @@
 #include <cassert>
 
 #include <iostream>
+#include <memory>
 #include <string>
 #include <utility>
 
@@ -79,6 +80,93 @@ protected:
   }
 };
 
+static unsigned _nCopyings = 0U;
+
+static unsigned _nMovings = 0U;
+
+class _TestArgument {
+public:
+  _TestArgument(void) = default;
+
+  _TestArgument(_TestArgument const &testArgument) noexcept
+  {
+    ++_nCopyings;
+  }
+
+  _TestArgument(_TestArgument &&testArgument) noexcept
+  {
+    ++_nMovings;
+  }
+};
+
+class _TestRefCountingForwarding: public RefCounting {
+public:
+  _TestRefCountingForwarding(_TestArgument const &testArgument, unique_ptr<int> pointer):
+    _testArgument(testArgument),
+    _pointer(move(pointer))
+  {}
+
+  _TestRefCountingForwarding(_TestArgument &&testArgument): _testArgument(move(testArgument)) {}
+
+protected:
+  ~_TestRefCountingForwarding()
+  {
+    _destructed = this;
+  }
+
+private:
+  _TestArgument _testArgument;
+
+  unique_ptr<int> _pointer;
+};
+
+class _TestStaticRefCounting final: public StaticRefCounting<_TestStaticRefCounting> {
+public:
+  _TestStaticRefCounting(void) noexcept
+  {
+    ++_nConstructings;
+
+    _constructed = this;
+  }
+
+private:
+  ~_TestStaticRefCounting() noexcept
+  {
+    _destructed = this;
+  }
+
+  friend class StaticRefCounting<_TestStaticRefCounting>;
+};
+
+static unsigned _nAllocatings = 0U;
+
+static unsigned _nDeallocatings = 0U;
+
+template <class T>
+class _TestAllocator {
+public:
+  typedef T value_type;
+
+  _TestAllocator(void) = default;
+
+  template <class U>
+  _TestAllocator(_TestAllocator<U> const &testAllocator) noexcept {}
+
+  T *allocate(size_t n)
+  {
+    ++_nAllocatings;
+
+    return allocator<T>().allocate(n);
+  }
+
+  void deallocate(T *pointer, size_t n) noexcept
+  {
+    ++_nDeallocatings;
+
+    allocator<T>().deallocate(pointer, n);
+  }
+};
+
 class _TestRefCountingDerived: public _TestRefCounting {
 public:
   _TestRefCountingDerived(void) = default;
@@ -1505,6 +1593,78 @@ int main(int argc, char const *argv[])
     _recoverState();
   }
 
+  {
+    _TestArgument ta;
+
+    AutoPtr<_TestRefCountingForwarding> trcf = NEW<_TestRefCountingForwarding>(
+        ta,
+        unique_ptr<int>(new int(7)));
+
+    assert(_nCopyings == 1U);
+
+    assert(_nMovings == 0U);
+
+    trcf = NEW<_TestRefCountingForwarding>(move(ta));
+
+    assert(_nCopyings == 1U);
+
+    assert(_nMovings == 1U);
+
+    trcf = nullptr;
+
+    assert(_destructed);
+
+    _recoverState();
+  }
+
+  {
+    AutoPtr<_TestStaticRefCounting> tsrc = NEW<_TestStaticRefCounting>();
+
+    assert(tsrc == _constructed);
+
+    AutoPtr<_TestStaticRefCounting> _tsrc = tsrc;
+
+    tsrc = nullptr;
+
+    assert(!_destructed);
+
+    _tsrc = nullptr;
+
+    assert(_destructed == _constructed);
+
+    _recoverState();
+  }
+
+  {
+    AutoPtr<_TestRefCounting> trc = ALLOCATE<_TestRefCounting>(
+        _TestAllocator<_TestRefCounting>(),
+        _NEW__ARGUMENTS);
+
+    assert(trc == _constructed);
+
+    assert(_nConstructings == 1U);
+
+    assert(_constructorArguments == Arguments(_NEW__ARGUMENTS));
+
+    assert(_nAllocatings == 1U);
+
+    assert(_nDeallocatings == 0U);
+
+    AutoPtr<_TestRefCounting> _trc = trc;
+
+    trc = nullptr;
+
+    assert(!_destructed);
+
+    _trc = nullptr;
+
+    assert(_destructed == _constructed);
+
+    assert(_nDeallocatings == 1U);
+
+    _recoverState();
+  }
+
   cout << "\"test-auto-ptr\" passed." << endl;
 
   return 0;
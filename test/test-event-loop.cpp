@@ -0,0 +1,426 @@
+/*
+ *
+ * Author: Kevin XU <kevin.xu.1982.02.06@gmail.com>
+ *
+ */
+
+#include <cassert>
+#include <cstdlib>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "../include/event-loop.hpp"
+#include "../include/signaling.hpp"
+
+#include "rand.hpp"
+
+
+#define _RAND_MAX 1024
+
+#define _N_THREADS 4
+
+
+
+using namespace std;
+
+using namespace Test;
+
+class _TestSignaling: public Signaling {
+public:
+  enum {
+    SIGNAL_PASS_INT
+  };
+
+  void notify(int value) noexcept
+  {
+    emit<SIGNAL_PASS_INT>(this, value);
+  }
+};
+
+template <>
+struct Signaling::SIGNALIZE<_TestSignaling, _TestSignaling::SIGNAL_PASS_INT> {
+  typedef Signaling::SIGNATURE<int> SIGNATURE;
+};
+
+template <>
+struct Signaling::SIGNALS<_TestSignaling> {
+  static int constexpr COUNT = 1;
+
+  static bool constexpr CONCURRENT = true;
+};
+
+static int _nBiasedLives = 0;
+
+class _TestBiasedSignaling: public Signaling, public BiasedRefCounting {
+public:
+  enum {
+    SIGNAL_PASS_INT
+  };
+
+  _TestBiasedSignaling(void) noexcept
+  {
+    ++_nBiasedLives;
+  }
+
+  void notify(int value) noexcept
+  {
+    emit<SIGNAL_PASS_INT>(this, value);
+  }
+
+protected:
+  ~_TestBiasedSignaling()
+  {
+    --_nBiasedLives;
+  }
+};
+
+template <>
+struct Signaling::SIGNALIZE<_TestBiasedSignaling, _TestBiasedSignaling::SIGNAL_PASS_INT> {
+  typedef Signaling::SIGNATURE<int> SIGNATURE;
+};
+
+static int _nPinnedLives = 0;
+
+class _TestPinnedSignaling: public Signaling, public AtomicRefCounting {
+public:
+  enum {
+    SIGNAL_PASS_INT
+  };
+
+  _TestPinnedSignaling(void) noexcept
+  {
+    ++_nPinnedLives;
+  }
+
+  void notify(int value) noexcept
+  {
+    emit<SIGNAL_PASS_INT>(this, value);
+  }
+
+protected:
+  ~_TestPinnedSignaling()
+  {
+    --_nPinnedLives;
+  }
+};
+
+template <>
+struct Signaling::SIGNALIZE<_TestPinnedSignaling, _TestPinnedSignaling::SIGNAL_PASS_INT> {
+  typedef Signaling::SIGNATURE<int> SIGNATURE;
+};
+
+static EventLoop *_eventLoop = nullptr;
+
+static thread::id _loopThreadId;
+
+static long _sum = 0L;
+
+static unsigned _nDetachingData = 0U;
+
+static void _detachData(void *data) noexcept
+{
+  assert(data != nullptr);
+
+  ++_nDetachingData;
+}
+
+static void _handlePassInt(_TestSignaling &ts, int value, void *data) noexcept
+{
+  assert(this_thread::get_id() == _loopThreadId);
+
+  assert(EventLoop::current() == _eventLoop);
+
+  assert(data != nullptr);
+
+  _sum += value;
+}
+
+static unsigned _nCoalescings = 0U;
+
+static int _coalescedValue = -1;
+
+static Executor::Clock::time_point _coalescedTime;
+
+static void _handleCoalescedPassInt(_TestSignaling &ts, int value, void *data) noexcept
+{
+  ++_nCoalescings;
+
+  _coalescedValue = value;
+
+  _coalescedTime = Executor::Clock::now();
+}
+
+static int _biasedValue = -1;
+
+static void _handleBiasedPassInt(_TestBiasedSignaling &tbs, int value, void *data) noexcept
+{
+  assert(_nBiasedLives == 1);
+
+  _biasedValue = value;
+}
+
+static int _pinnedValue = -1;
+
+static void _handlePinnedPassInt(_TestPinnedSignaling &tps, int value, void *data) noexcept
+{
+  assert(_nPinnedLives == 1);
+
+  _pinnedValue = value;
+}
+
+static void _notify(_TestSignaling *ts, int n) noexcept
+{
+  for (int i = 0; i < n; ++i)
+    ts->notify(i);
+}
+
+static void _run(EventLoop *eventLoop)
+{
+  _loopThreadId = this_thread::get_id();
+
+  eventLoop->run();
+}
+
+int main(int argc, char const *argv[])
+{
+  char *data = new char;
+
+  {
+    EventLoop eventLoop;
+
+    _eventLoop = &eventLoop;
+
+    assert(EventLoop::current() == nullptr);
+
+    _loopThreadId = this_thread::get_id();
+
+    int value = 0;
+
+    eventLoop.post([&value] () {
+      value = 25;
+    });
+
+    assert(value == 0);
+
+    assert(eventLoop.runOnce() == 1UL);
+
+    assert(value == 25);
+
+    eventLoop.stop();
+
+    assert(eventLoop.runOnce() == 0UL);
+
+    eventLoop.run();
+
+    Executor::Clock::time_point time = Executor::Clock::now() + chrono::milliseconds(20);
+
+    eventLoop.post([&value] () {
+      value = 1;
+    }, time);
+
+    eventLoop.post([&value] () {
+      value = 2;
+    });
+
+    assert(eventLoop.runOnce() == 1UL);
+
+    assert(value == 2);
+
+    assert(eventLoop.runOnce() == 1UL);
+
+    assert(value == 1);
+
+    assert(Executor::Clock::now() >= time);
+  }
+
+  {
+    EventLoop eventLoop;
+
+    AutoPtr<_TestBiasedSignaling> tbs = NEW<_TestBiasedSignaling>();
+
+    _TestBiasedSignaling::connect<_TestBiasedSignaling::SIGNAL_PASS_INT>(
+        static_cast<_TestBiasedSignaling *>(tbs),
+        eventLoop,
+        &_handleBiasedPassInt);
+
+    tbs->notify(1);
+
+    assert(eventLoop.runOnce() == 1UL);
+
+    assert(_biasedValue == 1);
+
+    tbs->notify(2);
+
+    tbs = nullptr;
+
+    assert(_nBiasedLives == 1);
+
+    assert(eventLoop.runOnce() == 1UL);
+
+    assert(_biasedValue == 2);
+
+    assert(_nBiasedLives == 0);
+  }
+
+  {
+    EventLoop eventLoop;
+
+    AutoPtr<_TestPinnedSignaling> tps = NEW<_TestPinnedSignaling>();
+
+    _TestPinnedSignaling::connect<_TestPinnedSignaling::SIGNAL_PASS_INT>(
+        static_cast<_TestPinnedSignaling *>(tps),
+        eventLoop,
+        &_handlePinnedPassInt);
+
+    tps->notify(3);
+
+    tps = nullptr;
+
+    assert(_nPinnedLives == 1);
+
+    assert(eventLoop.runOnce() == 1UL);
+
+    assert(_pinnedValue == 3);
+
+    assert(_nPinnedLives == 0);
+  }
+
+  {
+    EventLoop eventLoop;
+
+    AutoPtr<_TestBiasedSignaling> tbs = NEW<_TestBiasedSignaling>();
+
+    _TestBiasedSignaling::connect<_TestBiasedSignaling::SIGNAL_PASS_INT>(
+        static_cast<_TestBiasedSignaling *>(tbs),
+        eventLoop,
+        Signaling::Coalescing{chrono::milliseconds(20)},
+        &_handleBiasedPassInt);
+
+    tbs->notify(4);
+
+    tbs->notify(5);
+
+    tbs = nullptr;
+
+    assert(_nBiasedLives == 1);
+
+    assert(eventLoop.runOnce() == 1UL);
+
+    assert(_biasedValue == 5);
+
+    assert(_nBiasedLives == 0);
+  }
+
+  {
+    EventLoop eventLoop;
+
+    AutoPtr<_TestPinnedSignaling> tps = NEW<_TestPinnedSignaling>();
+
+    _TestPinnedSignaling::connect<_TestPinnedSignaling::SIGNAL_PASS_INT>(
+        static_cast<_TestPinnedSignaling *>(tps),
+        eventLoop,
+        Signaling::Coalescing{chrono::milliseconds(20)},
+        &_handlePinnedPassInt);
+
+    tps->notify(6);
+
+    tps->notify(7);
+
+    tps = nullptr;
+
+    assert(_nPinnedLives == 1);
+
+    assert(eventLoop.runOnce() == 1UL);
+
+    assert(_pinnedValue == 7);
+
+    assert(_nPinnedLives == 0);
+  }
+
+  {
+    _TestSignaling ts;
+
+    EventLoop eventLoop;
+
+    _TestSignaling::connect<_TestSignaling::SIGNAL_PASS_INT>(
+        &ts,
+        eventLoop,
+        Signaling::Coalescing{chrono::milliseconds(20)},
+        &_handleCoalescedPassInt);
+
+    int n = rand(_RAND_MAX) + 1;
+
+    for (int i = 0; i < n; ++i)
+      ts.notify(i);
+
+    assert(eventLoop.runOnce() == 1UL);
+
+    assert(_nCoalescings == 1U);
+
+    assert(_coalescedValue == n - 1);
+
+    Executor::Clock::time_point first = _coalescedTime;
+
+    ts.notify(n);
+
+    ts.notify(n + 1);
+
+    assert(eventLoop.runOnce() == 1UL);
+
+    assert(_coalescedTime >= first + chrono::milliseconds(20));
+
+    assert(_nCoalescings == 2U);
+
+    assert(_coalescedValue == n + 1);
+  }
+
+  {
+    _TestSignaling ts;
+
+    int n = rand(_RAND_MAX) + 1;
+
+    {
+      EventLoop eventLoop;
+
+      _eventLoop = &eventLoop;
+
+      _TestSignaling::connect<_TestSignaling::SIGNAL_PASS_INT>(
+          &ts,
+          eventLoop,
+          &_handlePassInt,
+          data,
+          &_detachData);
+
+      _loopThreadId = thread::id();
+
+      thread loopThread(&_run, &eventLoop);
+
+      vector<thread> threads;
+
+      for (int i = 0; i < _N_THREADS; ++i)
+        threads.emplace_back(&_notify, &ts, n);
+
+      for (auto i = threads.begin(), end = threads.end(); i != end; ++i)
+        i->join();
+
+      ts.disconnect();
+
+      eventLoop.post([&eventLoop] () {
+        eventLoop.stop();
+      });
+
+      loopThread.join();
+
+      assert(_nDetachingData == 1U);
+    }
+
+    assert(_sum == _N_THREADS * (static_cast<long>(n) * (n - 1) / 2));
+  }
+
+  delete data;
+
+  return 0;
+}
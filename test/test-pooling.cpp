@@ -0,0 +1,205 @@
+/*
+ *
+ * Author: Kevin XU <kevin.xu.1982.02.06@gmail.com>
+ *
+ */
+
+#include <cassert>
+#include <cstdlib>
+
+#include <iostream>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "../include/auto-ptr.hpp"
+#include "../include/pooling.hpp"
+#include "../include/ref-counting.hpp"
+
+#include "rand.hpp"
+
+
+#define _RAND_MAX 1024
+
+
+
+using namespace std;
+
+using namespace Test;
+
+static unsigned _nDestructings = 0U;
+
+template <size_t size>
+class _TestPooling: public RefCounting, public Pooling {
+public:
+  _TestPooling(void) = default;
+
+protected:
+  ~_TestPooling() noexcept
+  {
+    ++_nDestructings;
+  }
+
+private:
+  char _padding[size];
+};
+
+class alignas(64) _TestAlignedPooling: public RefCounting, public Pooling {
+public:
+  _TestAlignedPooling(void) = default;
+
+protected:
+  ~_TestAlignedPooling() = default;
+};
+
+class _TestSurvivor: public RefCounting, public Pooling {
+public:
+  _TestSurvivor(void) = default;
+
+protected:
+  ~_TestSurvivor() = default;
+
+private:
+  char _padding[16];
+};
+
+static AutoPtr<_TestSurvivor> _survivor;
+
+static thread_local AutoPtr<_TestSurvivor> _threadSurvivor;
+
+static void _outlive(void)
+{
+  _threadSurvivor = nullptr;
+
+  _threadSurvivor = NEW<_TestSurvivor>();
+}
+
+template <size_t size>
+static void _construct(vector<AutoPtr<_TestPooling<size>>> *tps, unsigned n)
+{
+  for (unsigned i = 0U; i < n; ++i)
+    tps->emplace_back(NEW<_TestPooling<size>>());
+}
+
+int main(int argc, char const *argv[])
+{
+  {
+    vector<AutoPtr<_TestAlignedPooling>> tps;
+
+    unsigned n = rand(_RAND_MAX) + 1;
+
+    for (unsigned i = 0U; i < n; ++i) {
+      tps.emplace_back(NEW<_TestAlignedPooling>());
+
+      assert(reinterpret_cast<uintptr_t>((_TestAlignedPooling *)tps.back()) % 64UL == 0UL);
+    }
+  }
+
+  {
+    thread outliver(&_outlive);
+
+    outliver.join();
+
+    _survivor = NEW<_TestSurvivor>();
+  }
+
+  {
+    unsigned n = rand(_RAND_MAX) + 1;
+
+    vector<AutoPtr<_TestPooling<8>>> tps;
+
+    _construct(&tps, n);
+
+    set<void *> pointers;
+
+    for (auto i = tps.begin(), end = tps.end(); i != end; ++i) {
+      assert(reinterpret_cast<uintptr_t>((_TestPooling<8> *)*i) % 16UL == 0UL);
+
+      pointers.emplace((_TestPooling<8> *)*i);
+    }
+
+    assert(pointers.size() == n);
+
+    tps.clear();
+
+    assert(_nDestructings == n);
+
+    _nDestructings = 0U;
+
+    _construct(&tps, 1U);
+
+    void *pointer = (_TestPooling<8> *)tps.back();
+
+    tps.clear();
+
+    _construct(&tps, 1U);
+
+    assert((_TestPooling<8> *)tps.back() == pointer);
+
+    tps.clear();
+
+    _nDestructings = 0U;
+  }
+
+  {
+    unsigned n = rand(_RAND_MAX) + 1;
+
+    vector<AutoPtr<_TestPooling<64>>> tps;
+
+    thread(&_construct<64>, &tps, n).join();
+
+    assert(tps.size() == n);
+
+    tps.clear();
+
+    assert(_nDestructings == n);
+
+    _nDestructings = 0U;
+
+    vector<AutoPtr<_TestPooling<1024>>> _tps;
+
+    _construct(&_tps, n);
+
+    _tps.clear();
+
+    assert(_nDestructings == n);
+
+    _nDestructings = 0U;
+  }
+
+  {
+    unsigned n = rand(_RAND_MAX) + 1;
+
+    vector<AutoPtr<_TestPooling<32>>> tps;
+
+    {
+      Pooling::Arena arena;
+
+      _construct(&tps, n);
+
+      for (unsigned i = 1U; i < n; ++i) {
+        char *pointer = reinterpret_cast<char *>((_TestPooling<32> *)tps[i]);
+
+        char *previous = reinterpret_cast<char *>((_TestPooling<32> *)tps[i - 1U]);
+
+        assert(pointer - previous == sizeof(_TestPooling<32>) || pointer < previous);
+      }
+
+      tps.clear();
+
+      assert(_nDestructings == n);
+    }
+
+    _nDestructings = 0U;
+
+    _construct(&tps, n);
+
+    tps.clear();
+
+    assert(_nDestructings == n);
+  }
+
+  cout << "\"test-pooling\" passed." << endl;
+
+  return 0;
+}
@@ -0,0 +1,195 @@
+/*
+ *
+ * Author: Kevin XU <kevin.xu.1982.02.06@gmail.com>
+ *
+ */
+
+#include <cassert>
+#include <cstdlib>
+
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include <utility>
+
+#include "../include/auto-ptr.hpp"
+#include "../include/reclaiming.hpp"
+#include "../include/ref-counting.hpp"
+
+#include "rand.hpp"
+
+
+#define _RAND_MAX 1024
+
+
+
+using namespace std;
+
+using namespace Test;
+
+static atomic<int> _nLives(0);
+
+static atomic<int> _nForeignDestructings(0);
+
+static thread::id _mainThreadId;
+
+class _TestReclaiming: public Deferring<RefCounting> {
+public:
+  _TestReclaiming(_TestReclaiming const *next = nullptr) noexcept: _next(next)
+  {
+    ++_nLives;
+  }
+
+protected:
+  ~_TestReclaiming() noexcept
+  {
+    if (_next != nullptr)
+      _next->deref();
+
+    --_nLives;
+  }
+
+private:
+  _TestReclaiming const *const _next;
+};
+
+static_assert(RefCounting::CHECK<_TestReclaiming>::value, "");
+
+class _TestAtomicReclaiming: public Deferring<AtomicRefCounting> {
+public:
+  _TestAtomicReclaiming(void) noexcept
+  {
+    ++_nLives;
+  }
+
+protected:
+  ~_TestAtomicReclaiming() noexcept
+  {
+    if (this_thread::get_id() != _mainThreadId)
+      ++_nForeignDestructings;
+
+    --_nLives;
+  }
+};
+
+static_assert(RefCounting::CHECK<_TestAtomicReclaiming>::value, "");
+
+static void _retire(int n)
+{
+  for (int i = 0; i < n; ++i)
+    NEW<_TestReclaiming>();
+
+  assert(Reclaiming::pending() == static_cast<size_t>(n));
+}
+
+int main(int argc, char const *argv[])
+{
+  _mainThreadId = this_thread::get_id();
+
+  AutoPtr<_TestReclaiming> autoPtr = NEW<_TestReclaiming>();
+
+  assert(_nLives == 1);
+
+  autoPtr = nullptr;
+
+  assert(_nLives == 1);
+
+  assert(Reclaiming::pending() == 1UL);
+
+  assert(Reclaiming::reclaim() == 1UL);
+
+  assert(_nLives == 0);
+
+  assert(Reclaiming::pending() == 0UL);
+
+  int n = rand(_RAND_MAX) + 1;
+
+  for (int i = 0; i < n; ++i) {
+    _TestReclaiming *next = autoPtr;
+
+    autoPtr = NEW<_TestReclaiming>(next != nullptr ? next->ref<_TestReclaiming>() : nullptr);
+  }
+
+  assert(_nLives == n);
+
+  autoPtr = nullptr;
+
+  for (int i = n; i > 0; --i) {
+    assert(Reclaiming::pending() == 1UL);
+
+    assert(Reclaiming::reclaim(1UL) == 1UL);
+
+    assert(_nLives == i - 1);
+  }
+
+  assert(Reclaiming::pending() == 0UL);
+
+  assert(Reclaiming::reclaim() == 0UL);
+
+  n = rand(_RAND_MAX) + 1;
+
+  thread(&_retire, n).join();
+
+  assert(_nLives == 0);
+
+  n = rand(_RAND_MAX) + 1;
+
+  {
+    Reclaiming::Reclaimer reclaimer;
+
+    for (int i = 0; i < n; ++i)
+      NEW<_TestAtomicReclaiming>();
+
+    Reclaiming::handOff();
+
+    assert(Reclaiming::pending() == 0UL);
+  }
+
+  assert(_nLives == 0);
+
+  assert(_nForeignDestructings == n);
+
+  NEW<_TestAtomicReclaiming>();
+
+  assert(!Reclaiming::handOff());
+
+  assert(Reclaiming::reclaim() == 1UL);
+
+  assert(_nForeignDestructings == n);
+
+  assert(_nLives == 0);
+
+  n = rand(_RAND_MAX) + 1;
+
+  {
+    AutoPtr<_TestReclaiming> child = NEW<_TestReclaiming>();
+
+    {
+      Reclaiming::Reclaimer reclaimer;
+
+      for (int i = 0; i < n; ++i) {
+        NEW<_TestReclaiming>(child->ref<_TestReclaiming>());
+
+        NEW<_TestAtomicReclaiming>();
+      }
+
+      Reclaiming::handOff();
+    }
+
+    assert(Reclaiming::pending() == static_cast<size_t>(n));
+
+    assert(_nLives == n + 1);
+
+    assert(Reclaiming::reclaim() == static_cast<size_t>(n));
+
+    assert(_nLives == 1);
+  }
+
+  assert(Reclaiming::reclaim() == 1UL);
+
+  assert(_nLives == 0);
+
+  cout << "\"test-reclaiming\" passed." << endl;
+
+  return 0;
+}
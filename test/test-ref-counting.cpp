@@ -8,6 +8,8 @@
 #include <cstdlib>
 
 #include <iostream>
+#include <thread>
+#include <vector>
 
 #include "../include/ref-counting.hpp"
 
@@ -16,6 +18,8 @@
 
 #define _RAND_MAX 1024
 
+#define _N_THREADS 4
+
 
 
 using namespace std;
@@ -37,6 +41,96 @@ protected:
 
 static_assert(RefCounting::CHECK<_TestRefCounting>::value, "");
 
+static unsigned _nStaticDestructings = 0U;
+
+class _TestStaticRefCounting final: public StaticRefCounting<_TestStaticRefCounting> {
+public:
+  _TestStaticRefCounting(void) = default;
+
+private:
+  ~_TestStaticRefCounting() noexcept
+  {
+    ++_nStaticDestructings;
+  }
+
+  friend class StaticRefCounting<_TestStaticRefCounting>;
+};
+
+static_assert(RefCounting::CHECK<_TestStaticRefCounting>::value, "");
+
+static_assert(sizeof(_TestStaticRefCounting) < sizeof(_TestRefCounting), "");
+
+class _TestStaticRefCountingBase: public StaticRefCounting<_TestStaticRefCountingBase> {
+protected:
+  ~_TestStaticRefCountingBase() = default;
+
+  friend class StaticRefCounting<_TestStaticRefCountingBase>;
+};
+
+class _TestStaticRefCountingDerived: public _TestStaticRefCountingBase {
+protected:
+  ~_TestStaticRefCountingDerived() = default;
+};
+
+static_assert(RefCounting::CHECK<_TestStaticRefCountingBase>::value, "");
+
+static_assert(!RefCounting::CHECK<_TestStaticRefCountingDerived>::value, "");
+
+static bool _atomicDestructed = false;
+
+class _TestAtomicRefCounting: public AtomicRefCounting {
+public:
+  _TestAtomicRefCounting(void) = default;
+
+protected:
+  ~_TestAtomicRefCounting() noexcept
+  {
+    _atomicDestructed = true;
+  }
+};
+
+static_assert(RefCounting::CHECK<_TestAtomicRefCounting>::value, "");
+
+static unsigned _nBiasedDestructings = 0U;
+
+class _TestBiasedRefCounting: public BiasedRefCounting {
+public:
+  _TestBiasedRefCounting(void) = default;
+
+protected:
+  ~_TestBiasedRefCounting() noexcept
+  {
+    ++_nBiasedDestructings;
+  }
+};
+
+static_assert(RefCounting::CHECK<_TestBiasedRefCounting>::value, "");
+
+template <class RC>
+static void _refAndDeref(RC const *rc, int n) noexcept
+{
+  for (int i = 0; i < n; ++i)
+    rc->ref();
+
+  for (int i = 0; i < n; ++i)
+    rc->deref();
+}
+
+template <class RC>
+static void _deref(RC const *rc, int n) noexcept
+{
+  for (int i = 0; i < n; ++i)
+    rc->deref();
+}
+
+static void _constructBiased(_TestBiasedRefCounting **tbrc, int n) noexcept
+{
+  *tbrc = new _TestBiasedRefCounting();
+
+  for (int i = 0; i < n; ++i)
+    (*tbrc)->ref();
+}
+
 int main(int argc, char const *argv[])
 {
   _TestRefCounting *trc = new _TestRefCounting();
@@ -109,6 +203,115 @@ int main(int argc, char const *argv[])
 
   assert(_destructed);
 
+  _TestStaticRefCounting *tsrc = new _TestStaticRefCounting();
+
+  n = rand(_RAND_MAX);
+
+  for (int i = 0; i < n; ++i) {
+    _TestStaticRefCounting *_tsrc = tsrc->ref<_TestStaticRefCounting>();
+
+    assert(_tsrc == tsrc);
+  }
+
+  for (int i = 0; i < n; ++i)
+    tsrc->deref();
+
+  assert(_nStaticDestructings == 0U);
+
+  tsrc->deref();
+
+  assert(_nStaticDestructings == 1U);
+
+  _TestAtomicRefCounting *tarc = new _TestAtomicRefCounting();
+
+  vector<thread> threads;
+
+  for (int i = 0; i < _N_THREADS; ++i)
+    threads.emplace_back(&_refAndDeref<_TestAtomicRefCounting>, tarc, rand(_RAND_MAX) * _RAND_MAX);
+
+  for (auto i = threads.begin(), end = threads.end(); i != end; ++i)
+    i->join();
+
+  assert(!_atomicDestructed);
+
+  n = rand(_RAND_MAX);
+
+  for (int i = 0; i < n; ++i) {
+    _TestAtomicRefCounting *_tarc = tarc->ref<_TestAtomicRefCounting>();
+
+    assert(_tarc == tarc);
+  }
+
+  for (int i = 0; i < n; ++i)
+    tarc->deref();
+
+  assert(!_atomicDestructed);
+
+  tarc->deref();
+
+  assert(_atomicDestructed);
+
+  _TestBiasedRefCounting *tbrc = new _TestBiasedRefCounting();
+
+  threads.clear();
+
+  for (int i = 0; i < _N_THREADS; ++i)
+    threads.emplace_back(&_refAndDeref<_TestBiasedRefCounting>, tbrc, rand(_RAND_MAX) * _RAND_MAX);
+
+  _refAndDeref(tbrc, rand(_RAND_MAX) * _RAND_MAX);
+
+  for (auto i = threads.begin(), end = threads.end(); i != end; ++i)
+    i->join();
+
+  assert(_nBiasedDestructings == 0U);
+
+  tbrc->deref();
+
+  assert(_nBiasedDestructings == 1U);
+
+  tbrc = new _TestBiasedRefCounting();
+
+  n = rand(_RAND_MAX) + 1;
+
+  for (int i = 0; i < n; ++i)
+    tbrc->ref();
+
+  thread(&_deref<_TestBiasedRefCounting>, tbrc, n).join();
+
+  assert(_nBiasedDestructings == 1U);
+
+  BiasedRefCounting::collect();
+
+  assert(_nBiasedDestructings == 1U);
+
+  tbrc->deref();
+
+  assert(_nBiasedDestructings == 2U);
+
+  tbrc = new _TestBiasedRefCounting();
+
+  tbrc->ref();
+
+  thread(&_deref<_TestBiasedRefCounting>, tbrc, 2).join();
+
+  assert(_nBiasedDestructings == 2U);
+
+  BiasedRefCounting::collect();
+
+  assert(_nBiasedDestructings == 3U);
+
+  n = rand(_RAND_MAX) + 1;
+
+  thread(&_constructBiased, &tbrc, n).join();
+
+  _deref(tbrc, n);
+
+  assert(_nBiasedDestructings == 3U);
+
+  tbrc->deref();
+
+  assert(_nBiasedDestructings == 4U);
+
   cout << "\"test-ref-counting\" passed." << endl;
 
   return 0;
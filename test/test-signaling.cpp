@@ -7,12 +7,16 @@
 #include <cassert>
 #include <cstdlib>
 
+#include <atomic>
 #include <iostream>
+#include <memory>
 #include <set>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "../include/signaling.hpp"
+#include "../include/thread-pool.hpp"
 
 #include "arguments.hpp"
 #include "rand.hpp"
@@ -26,6 +30,8 @@
 
 #define _RAND_MAX 1024
 
+#define _N_THREADS 4
+
 
 
 using namespace std;
@@ -48,6 +54,12 @@ public:
   {
     emit<signal>(this, arguments...);
   }
+
+  template <int signal, class E>
+  void notifyBatch(vector<E> const &events) noexcept
+  {
+    emitBatch<signal>(this, events.data(), events.size());
+  }
 };
 
 template <>
@@ -60,6 +72,138 @@ struct Signaling::SIGNALIZE<_TestSignaling, _TestSignaling::SIGNAL_PASS_NON_VOID
   typedef Signaling::SIGNATURE<_PASS_NON_VOID_FIXED__SIGNATURE> SIGNATURE;
 };
 
+static_assert(Signaling::SIGNALS<_TestSignaling>::COUNT == 2, "");
+
+class _TestExtendedSignaling: public _TestSignaling {
+public:
+  enum {
+    SIGNAL_EXTENDED = SIGNAL_PASS_NON_VOID_FIXED + 1
+  };
+
+  void notifyExtended(void) noexcept
+  {
+    emit<SIGNAL_EXTENDED>(this);
+  }
+};
+
+template <>
+struct Signaling::SIGNALIZE<_TestExtendedSignaling, _TestExtendedSignaling::SIGNAL_EXTENDED> {
+  typedef Signaling::SIGNATURE<void> SIGNATURE;
+};
+
+class _TestSparseSignaling: public Signaling {
+public:
+  enum {
+    SIGNAL_SPARSE = 3
+  };
+};
+
+template <>
+struct Signaling::SIGNALIZE<_TestSparseSignaling, _TestSparseSignaling::SIGNAL_SPARSE> {
+  typedef Signaling::SIGNATURE<void> SIGNATURE;
+};
+
+static_assert(Signaling::SIGNALS<_TestSparseSignaling>::COUNT == 4, "");
+
+class _TestWideSignaling: public Signaling {
+public:
+  enum {
+    SIGNAL_WIDE = 300
+  };
+
+  void notify(void) noexcept
+  {
+    emit<SIGNAL_WIDE>(this);
+  }
+};
+
+template <>
+struct Signaling::SIGNALIZE<_TestWideSignaling, _TestWideSignaling::SIGNAL_WIDE> {
+  typedef Signaling::SIGNATURE<void> SIGNATURE;
+};
+
+template <>
+struct Signaling::SIGNALS<_TestWideSignaling> {
+  static int constexpr COUNT = _TestWideSignaling::SIGNAL_WIDE + 1;
+};
+
+class _TestConcurrentSignaling: public Signaling {
+public:
+  enum {
+    SIGNAL_PASS_INT
+  };
+
+  void notify(int value) noexcept
+  {
+    emit<SIGNAL_PASS_INT>(this, value);
+  }
+};
+
+template <>
+struct Signaling::SIGNALIZE<_TestConcurrentSignaling, _TestConcurrentSignaling::SIGNAL_PASS_INT> {
+  typedef Signaling::SIGNATURE<int> SIGNATURE;
+};
+
+template <>
+struct Signaling::SIGNALS<_TestConcurrentSignaling> {
+  static int constexpr COUNT = 1;
+
+  static bool constexpr CONCURRENT = true;
+};
+
+static unsigned _nCopyings = 0U;
+
+class _Payload {
+public:
+  _Payload(void) = default;
+
+  _Payload(_Payload const &payload) noexcept
+  {
+    ++_nCopyings;
+  }
+};
+
+class _TestForwardingSignaling: public Signaling {
+public:
+  enum {
+    SIGNAL_PASS_PAYLOAD,
+    SIGNAL_PASS_PAYLOAD_BY_VALUE
+  };
+
+  template <int signal, class ... As>
+  void notify(As &&... arguments) noexcept
+  {
+    emit<signal>(this, std::forward<As>(arguments)...);
+  }
+};
+
+template <>
+struct Signaling::SIGNALIZE<
+  _TestForwardingSignaling,
+  _TestForwardingSignaling::SIGNAL_PASS_PAYLOAD> {
+  typedef Signaling::SIGNATURE<_Payload const &, string const &> SIGNATURE;
+};
+
+template <>
+struct Signaling::SIGNALIZE<
+  _TestForwardingSignaling,
+  _TestForwardingSignaling::SIGNAL_PASS_PAYLOAD_BY_VALUE> {
+  typedef Signaling::SIGNATURE<_Payload> SIGNATURE;
+};
+
+static unsigned _nPassingPayload = 0U;
+
+static void _handlePassPayload(
+    _TestForwardingSignaling &tfs,
+    _Payload const &payload,
+    string const &s,
+    void *data) noexcept
+{
+  assert(s == "xyz");
+
+  ++_nPassingPayload;
+}
+
 static unsigned _nPassingVoid = 0U;
 
 static vector<_TestSignaling *> _tssPassingVoid;
@@ -158,6 +302,149 @@ static void _handlePassNonVoidFixed(_TestSignaling &ts, As... arguments, void *d
   }
 }
 
+static atomic<unsigned> _nPassingInt(0U);
+
+static atomic<unsigned> _nDetachingDataPassingInt(0U);
+
+static void _detachDataPassingInt(void *data) noexcept
+{
+  assert(data != nullptr);
+
+  ++_nDetachingDataPassingInt;
+}
+
+static void _handlePassInt(_TestConcurrentSignaling &tcs, int value, void *data) noexcept
+{
+  assert(value >= 0);
+
+  assert(data != nullptr);
+
+  ++_nPassingInt;
+}
+
+static atomic<unsigned> _nQueuedPassingNonVoidFixed(0U);
+
+static atomic<unsigned> _nQueuedDetachingData(0U);
+
+static thread::id _queuedThreadId;
+
+static void _detachQueuedData(void *data) noexcept
+{
+  assert(data != nullptr);
+
+  ++_nQueuedDetachingData;
+}
+
+static void _handleQueuedPassNonVoidFixed(
+    _TestSignaling &ts,
+    _PASS_NON_VOID_FIXED__SIGNATURE,
+    void *data) noexcept
+{
+  assert(data != nullptr);
+
+  assert(this_thread::get_id() != _queuedThreadId);
+
+  ++_nQueuedPassingNonVoidFixed;
+}
+
+static int _nCaptureLives = 0;
+
+class _Capture {
+public:
+  _Capture(unsigned *count) noexcept: _count(count)
+  {
+    ++_nCaptureLives;
+  }
+
+  _Capture(_Capture const &capture) noexcept: _count(capture._count)
+  {
+    ++_nCaptureLives;
+  }
+
+  ~_Capture()
+  {
+    --_nCaptureLives;
+  }
+
+  void operator()(void) const noexcept
+  {
+    ++*_count;
+  }
+
+private:
+  unsigned *const _count;
+};
+
+class _TestReceiver {
+public:
+  unsigned nPassingVoid = 0U;
+
+  unsigned nPassingNonVoidFixed = 0U;
+
+  vector<int> *priorities = nullptr;
+
+  int priority = 0;
+
+  void onPassVoid(void) noexcept
+  {
+    ++nPassingVoid;
+
+    if (priorities != nullptr)
+      priorities->emplace_back(priority);
+  }
+
+  void onPassNonVoidFixed(
+      _TestSignaling &ts,
+      char c,
+      int i,
+      float f,
+      double d,
+      string const &s,
+      void *p) noexcept
+  {
+    assert(Arguments(c, i, f, d, s, p) == Arguments(_PASS_NON_VOID_FIXED__ARGUMENTS));
+
+    ++nPassingNonVoidFixed;
+  }
+};
+
+class _TestTrackedReceiver: public WeakRefCounting {
+public:
+  static unsigned nPassingVoid;
+
+  void onPassVoid(void) noexcept
+  {
+    ++nPassingVoid;
+  }
+
+protected:
+  ~_TestTrackedReceiver() = default;
+};
+
+unsigned _TestTrackedReceiver::nPassingVoid = 0U;
+
+static void _notifyConcurrently(_TestConcurrentSignaling *tcs, int n) noexcept
+{
+  for (int i = 0; i < n; ++i)
+    tcs->notify(i);
+}
+
+static void _connectConcurrently(_TestConcurrentSignaling *tcs, void *data, int n)
+{
+  vector<Signaling::ConnectionId> cis;
+
+  for (int i = 0; i < n; ++i) {
+    cis.emplace_back(_TestConcurrentSignaling::connect<_TestConcurrentSignaling::SIGNAL_PASS_INT>(
+          tcs,
+          &_handlePassInt,
+          data,
+          &_detachDataPassingInt));
+
+    if (i % 2 == 1)
+      tcs->disconnect(cis[i / 2]);
+  }
+}
+
 int main(int argc, char const *argv[])
 {
   _TestSignaling ts;
@@ -199,6 +486,11 @@ int main(int argc, char const *argv[])
 
   assert(_nDetachingDataPassingVoid == sis);
 
+  for (auto i = si.begin(), end = si.end(); i != end; ++i)
+    ts.disconnect(cis[*i]);
+
+  assert(_nDetachingDataPassingVoid == sis);
+
   for (auto i = _vdetachedDataPassingVoid.begin(), end = _vdetachedDataPassingVoid.end();
       i != end;
       ++i)
@@ -392,6 +684,721 @@ int main(int argc, char const *argv[])
 
   assert(_nPassingNonVoidFixed == 0U);
 
+  {
+    _TestConcurrentSignaling tcs;
+
+    int n = rand(_RAND_MAX) + 1;
+
+    vector<thread> threads;
+
+    for (int i = 0; i < _N_THREADS; ++i)
+      threads.emplace_back(&_notifyConcurrently, &tcs, (rand(_RAND_MAX) + 1) * 16);
+
+    threads.emplace_back(&_connectConcurrently, &tcs, data, n);
+
+    for (auto i = threads.begin(), end = threads.end(); i != end; ++i)
+      i->join();
+
+    assert(_nDetachingDataPassingInt == static_cast<unsigned>(n / 2));
+
+    tcs.notify(0);
+
+    unsigned nPassingInt = _nPassingInt;
+
+    tcs.notify(0);
+
+    assert(_nPassingInt - nPassingInt == static_cast<unsigned>(n - n / 2));
+
+    tcs.disconnect();
+
+    assert(_nDetachingDataPassingInt == static_cast<unsigned>(n));
+  }
+
+  {
+    _TestSignaling ts;
+
+    unsigned count = 0U;
+
+    unsigned n = rand(_RAND_MAX) + 1;
+
+    vector<Signaling::ConnectionId> cis;
+
+    for (unsigned i = 0U; i < n; ++i)
+      cis.emplace_back(_TestSignaling::connect<_TestSignaling::SIGNAL_PASS_VOID>(
+            &ts,
+            [capture = _Capture(&count)] (_TestSignaling &ts) {
+              capture();
+            }));
+
+    char large[64] = {};
+
+    Arguments arguments(_PASS_NON_VOID_FIXED__ARGUMENTS);
+
+    _TestSignaling::connect<_TestSignaling::SIGNAL_PASS_NON_VOID_FIXED>(
+        &ts,
+        [capture = _Capture(&count), large, &arguments] (
+            char c,
+            int i,
+            float f,
+            double d,
+            string const &s,
+            void *p) {
+          assert(large[0] == 0);
+
+          assert(Arguments(c, i, f, d, s, p) == arguments);
+
+          capture();
+        });
+
+    assert(_nCaptureLives == static_cast<int>(n + 1U));
+
+    ts.notify<_TestSignaling::SIGNAL_PASS_VOID>();
+
+    assert(count == n);
+
+    ts.notify<_TestSignaling::SIGNAL_PASS_NON_VOID_FIXED>(_PASS_NON_VOID_FIXED__ARGUMENTS);
+
+    assert(count == n + 1U);
+
+    ts.disconnect(cis[0]);
+
+    assert(_nCaptureLives == static_cast<int>(n));
+
+    ts.disconnect();
+
+    assert(_nCaptureLives == 0);
+
+    ts.notify<_TestSignaling::SIGNAL_PASS_VOID>();
+
+    assert(count == n + 1U);
+  }
+
+  {
+    _TestSignaling ts;
+
+    _TestReceiver tr;
+
+    _TestSignaling::connect<_TestSignaling::SIGNAL_PASS_VOID>(
+        &ts,
+        &_TestReceiver::onPassVoid,
+        &tr);
+
+    _TestSignaling::connect<_TestSignaling::SIGNAL_PASS_VOID, &_TestReceiver::onPassVoid>(
+        &ts,
+        &tr);
+
+    Signaling::ConnectionId ci = _TestSignaling::connect<
+      _TestSignaling::SIGNAL_PASS_NON_VOID_FIXED,
+      &_TestReceiver::onPassNonVoidFixed>(&ts, &tr);
+
+    _TestSignaling::connect<_TestSignaling::SIGNAL_PASS_NON_VOID_FIXED>(
+        &ts,
+        &_TestReceiver::onPassNonVoidFixed,
+        &tr);
+
+    ts.notify<_TestSignaling::SIGNAL_PASS_VOID>();
+
+    ts.notify<_TestSignaling::SIGNAL_PASS_NON_VOID_FIXED>(_PASS_NON_VOID_FIXED__ARGUMENTS);
+
+    assert(tr.nPassingVoid == 2U);
+
+    assert(tr.nPassingNonVoidFixed == 2U);
+
+    ts.disconnect(ci);
+
+    ts.notify<_TestSignaling::SIGNAL_PASS_NON_VOID_FIXED>(_PASS_NON_VOID_FIXED__ARGUMENTS);
+
+    assert(tr.nPassingNonVoidFixed == 3U);
+  }
+
+  {
+    _TestSignaling ts;
+
+    AutoPtr<_TestTrackedReceiver> ttr = NEW<_TestTrackedReceiver>();
+
+    Signaling::ConnectionId ci1 = _TestSignaling::connect<_TestSignaling::SIGNAL_PASS_VOID>(
+        &ts,
+        &_TestTrackedReceiver::onPassVoid,
+        WeakPtr<_TestTrackedReceiver>(ttr));
+
+    Signaling::ConnectionId ci2 = _TestSignaling::connect<
+      _TestSignaling::SIGNAL_PASS_VOID,
+      &_TestTrackedReceiver::onPassVoid>(&ts, WeakPtr<_TestTrackedReceiver>(ttr));
+
+    ts.notify<_TestSignaling::SIGNAL_PASS_VOID>();
+
+    assert(_TestTrackedReceiver::nPassingVoid == 2U);
+
+    ttr = nullptr;
+
+    ts.notify<_TestSignaling::SIGNAL_PASS_VOID>();
+
+    assert(_TestTrackedReceiver::nPassingVoid == 2U);
+
+    unsigned count = 0U;
+
+    Signaling::ConnectionId ci3 = _TestSignaling::connect<_TestSignaling::SIGNAL_PASS_VOID>(
+        &ts,
+        [&count] (void) {
+          ++count;
+        });
+
+    assert(ci3.subconnectionId == ci1.subconnectionId
+        || ci3.subconnectionId == ci2.subconnectionId);
+
+    ts.notify<_TestSignaling::SIGNAL_PASS_VOID>();
+
+    assert(count == 1U);
+
+    ts.disconnect(ci1);
+
+    ts.disconnect(ci2);
+
+    ts.notify<_TestSignaling::SIGNAL_PASS_VOID>();
+
+    assert(count == 2U);
+
+    ts.disconnect(ci3);
+
+    Signaling::ConnectionId ci4 = _TestSignaling::connect<_TestSignaling::SIGNAL_PASS_VOID>(
+        &ts,
+        [&count] (void) {
+          ++count;
+        });
+
+    assert(ci4.subconnectionId == ci3.subconnectionId);
+
+    ts.disconnect(ci3);
+
+    ts.notify<_TestSignaling::SIGNAL_PASS_VOID>();
+
+    assert(count == 3U);
+
+    ts.disconnect(ci4);
+
+    ts.notify<_TestSignaling::SIGNAL_PASS_VOID>();
+
+    assert(count == 3U);
+  }
+
+  {
+    _TestSignaling ts;
+
+    unsigned n = rand(_RAND_MAX) + 1;
+
+    vector<Signaling::EVENT<_TestSignaling, _TestSignaling::SIGNAL_PASS_NON_VOID_FIXED>> events(
+        n,
+        make_tuple(_PASS_NON_VOID_FIXED__ARGUMENTS));
+
+    _TestSignaling::connect<_TestSignaling::SIGNAL_PASS_NON_VOID_FIXED>(
+        &ts,
+        &_handlePassNonVoidFixed<_PASS_NON_VOID_FIXED__SIGNATURE>,
+        data);
+
+    typedef Signaling::BATCH<_TestSignaling, _TestSignaling::SIGNAL_PASS_NON_VOID_FIXED> Batch;
+
+    unsigned nBatches = 0U;
+
+    unsigned nEvents = 0U;
+
+    _TestSignaling::connect<_TestSignaling::SIGNAL_PASS_NON_VOID_FIXED>(
+        &ts,
+        [&nBatches, &nEvents] (_TestSignaling &ts, Batch const &batch) {
+          ++nBatches;
+
+          for (auto i = batch.begin(), end = batch.end(); i != end; ++i) {
+            assert(get<4>(*i) == "xyz");
+
+            ++nEvents;
+          }
+        });
+
+    ts.notifyBatch<_TestSignaling::SIGNAL_PASS_NON_VOID_FIXED>(events);
+
+    assert(_nPassingNonVoidFixed == n);
+
+    for (auto i = _argumentssPassingNonVoidFixed.begin(),
+        end = _argumentssPassingNonVoidFixed.end();
+        i != end;
+        ++i)
+      assert(*i == arguments);
+
+    assert(nBatches == 1U);
+
+    assert(nEvents == n);
+
+    ts.notify<_TestSignaling::SIGNAL_PASS_NON_VOID_FIXED>(_PASS_NON_VOID_FIXED__ARGUMENTS);
+
+    assert(_nPassingNonVoidFixed == n + 1U);
+
+    assert(nBatches == 2U);
+
+    assert(nEvents == n + 1U);
+
+    _recoverState();
+  }
+
+  {
+    _TestSignaling ts;
+
+    _TestReceiver tr;
+
+    vector<int> priorities;
+
+    vector<Signaling::ConnectionId> cis;
+
+    unsigned n = rand(_RAND_MAX) + 1;
+
+    for (unsigned i = 0U; i < n; ++i) {
+      int priority = rand(8) - 4;
+
+      cis.emplace_back(_TestSignaling::connect<_TestSignaling::SIGNAL_PASS_VOID>(
+            &ts,
+            Signaling::Priority{priority},
+            [&priorities, priority] (void) {
+              priorities.emplace_back(priority);
+            }));
+
+      if (rand(4) == 0)
+        ts.disconnect(cis[rand(static_cast<int>(cis.size()))]);
+    }
+
+    tr.priorities = &priorities;
+
+    tr.priority = 8;
+
+    _TestSignaling::connect<_TestSignaling::SIGNAL_PASS_VOID, &_TestReceiver::onPassVoid>(
+        &ts,
+        Signaling::Priority{8},
+        &tr);
+
+    ts.notify<_TestSignaling::SIGNAL_PASS_VOID>();
+
+    assert(tr.nPassingVoid == 1U);
+
+    assert(!priorities.empty());
+
+    assert(priorities.front() == 8);
+
+    for (size_t i = 1UL; i < priorities.size(); ++i) {
+      assert(priorities[i] < 8);
+
+      assert(priorities[i - 1UL] >= priorities[i]);
+    }
+
+    for (unsigned i = 0U; i < n; ++i)
+      ts.disconnect(cis[i]);
+
+    priorities.clear();
+
+    ts.notify<_TestSignaling::SIGNAL_PASS_VOID>();
+
+    assert(priorities == vector<int>{8});
+
+    assert(tr.nPassingVoid == 2U);
+  }
+
+  {
+    _TestSignaling ts;
+
+    unsigned n = rand(_RAND_MAX) + 2;
+
+    vector<unsigned> counts(n, 0U);
+
+    vector<Signaling::ConnectionId> cis(n);
+
+    unsigned nNews = 0U;
+
+    bool reentered = false;
+
+    for (unsigned i = 1U; i < n; ++i)
+      cis[i] = _TestSignaling::connect<_TestSignaling::SIGNAL_PASS_VOID>(
+          &ts,
+          [&counts, i] (void) {
+            ++counts[i];
+          });
+
+    cis[0] = _TestSignaling::connect<_TestSignaling::SIGNAL_PASS_VOID>(
+        &ts,
+        Signaling::Priority{1},
+        [&] (_TestSignaling &ts) {
+          ++counts[0];
+
+          if (reentered)
+            return;
+
+          reentered = true;
+
+          for (unsigned i = 1U; i < n; i += 2U)
+            ts.disconnect(cis[i]);
+
+          _TestSignaling::connect<_TestSignaling::SIGNAL_PASS_VOID>(
+              &ts,
+              [&nNews] (void) {
+                ++nNews;
+              });
+
+          ts.notify<_TestSignaling::SIGNAL_PASS_VOID>();
+        });
+
+    int nLives = _nCaptureLives;
+
+    unsigned nSelves = 0U;
+
+    Signaling::ConnectionId ci;
+
+    ci = _TestSignaling::connect<_TestSignaling::SIGNAL_PASS_VOID>(
+        &ts,
+        [&ts, &ci, &nLives, capture = _Capture(&nSelves)] (void) {
+          ts.disconnect(ci);
+
+          assert(_nCaptureLives == nLives + 1);
+
+          capture();
+        });
+
+    ts.notify<_TestSignaling::SIGNAL_PASS_VOID>();
+
+    assert(_nCaptureLives == nLives);
+
+    assert(nSelves == 1U);
+
+    assert(counts[0] == 2U);
+
+    for (unsigned i = 1U; i < n; ++i)
+      assert(counts[i] == (i % 2U == 1U ? 0U : 2U));
+
+    assert(nNews == 0U);
+
+    ts.notify<_TestSignaling::SIGNAL_PASS_VOID>();
+
+    assert(nSelves == 1U);
+
+    assert(counts[0] == 3U);
+
+    for (unsigned i = 1U; i < n; ++i)
+      assert(counts[i] == (i % 2U == 1U ? 0U : 3U));
+
+    assert(nNews == 1U);
+
+    ts.disconnect();
+  }
+
+  {
+    _TestForwardingSignaling tfs;
+
+    unsigned n = rand(_RAND_MAX) + 1;
+
+    for (unsigned i = 0U; i < n; ++i)
+      if (i % 2U == 0U)
+        _TestForwardingSignaling::connect<_TestForwardingSignaling::SIGNAL_PASS_PAYLOAD>(
+            &tfs,
+            &_handlePassPayload);
+      else
+        _TestForwardingSignaling::connect<_TestForwardingSignaling::SIGNAL_PASS_PAYLOAD>(
+            &tfs,
+            [] (_Payload const &payload, string const &s) {
+              assert(s == "xyz");
+
+              ++_nPassingPayload;
+            });
+
+    _Payload payload;
+
+    string s("xyz");
+
+    tfs.notify<_TestForwardingSignaling::SIGNAL_PASS_PAYLOAD>(payload, s);
+
+    tfs.notify<_TestForwardingSignaling::SIGNAL_PASS_PAYLOAD>(_Payload(), "xyz");
+
+    assert(_nPassingPayload == 2U * n);
+
+    assert(_nCopyings == 0U);
+  }
+
+  {
+    _TestForwardingSignaling tfs;
+
+    _Payload payload;
+
+    tfs.notify<_TestForwardingSignaling::SIGNAL_PASS_PAYLOAD_BY_VALUE>(payload);
+
+    assert(_nCopyings == 0U);
+
+    unsigned count = 0U;
+
+    Signaling::ConnectionId ci = _TestForwardingSignaling::connect<
+      _TestForwardingSignaling::SIGNAL_PASS_PAYLOAD_BY_VALUE>(
+        &tfs,
+        [&count] (_Payload payload) {
+          ++count;
+        });
+
+    tfs.notify<_TestForwardingSignaling::SIGNAL_PASS_PAYLOAD_BY_VALUE>(payload);
+
+    assert(count == 1U);
+
+    assert(_nCopyings != 0U);
+
+    tfs.disconnect(ci);
+
+    unsigned nCopyings = _nCopyings;
+
+    tfs.notify<_TestForwardingSignaling::SIGNAL_PASS_PAYLOAD_BY_VALUE>(payload);
+
+    assert(_nCopyings == nCopyings);
+  }
+
+  {
+    _TestSignaling ts1;
+
+    unsigned count1 = 0U;
+
+    unsigned count2 = 0U;
+
+    Signaling::ConnectionId ci = _TestSignaling::connect<_TestSignaling::SIGNAL_PASS_VOID>(
+        &ts1,
+        [&count1, payload = _Payload()] (void) {
+          ++count1;
+        });
+
+    _TestSignaling::connect<_TestSignaling::SIGNAL_PASS_VOID>(
+        &ts1,
+        [&count2, payload = _Payload()] (void) {
+          ++count2;
+        });
+
+    unsigned nCopyings = _nCopyings;
+
+    _TestSignaling ts2(ts1);
+
+    _TestSignaling ts3;
+
+    ts3 = ts2;
+
+    assert(_nCopyings == nCopyings);
+
+    ts2.notify<_TestSignaling::SIGNAL_PASS_VOID>();
+
+    ts3.notify<_TestSignaling::SIGNAL_PASS_VOID>();
+
+    assert(count1 == 2U && count2 == 2U);
+
+    ts2.disconnect(ci);
+
+    assert(_nCopyings != nCopyings);
+
+    ts1.notify<_TestSignaling::SIGNAL_PASS_VOID>();
+
+    assert(count1 == 3U && count2 == 3U);
+
+    ts2.notify<_TestSignaling::SIGNAL_PASS_VOID>();
+
+    assert(count1 == 3U && count2 == 4U);
+
+    ts3.notify<_TestSignaling::SIGNAL_PASS_VOID>();
+
+    assert(count1 == 4U && count2 == 5U);
+  }
+
+  {
+    _TestSignaling ts1;
+
+    unsigned count = 0U;
+
+    Signaling::ConnectionId ci;
+
+    _TestSignaling::connect<_TestSignaling::SIGNAL_PASS_VOID>(
+        &ts1,
+        [&ts1, &ci] (void) {
+          ts1.disconnect(ci);
+        });
+
+    ci = _TestSignaling::connect<_TestSignaling::SIGNAL_PASS_VOID>(
+        &ts1,
+        [&count] (void) {
+          ++count;
+        });
+
+    _TestSignaling ts2(ts1);
+
+    ts1.notify<_TestSignaling::SIGNAL_PASS_VOID>();
+
+    assert(count == 0U);
+
+    ts2.notify<_TestSignaling::SIGNAL_PASS_VOID>();
+
+    assert(count == 1U);
+
+    ts1.notify<_TestSignaling::SIGNAL_PASS_VOID>();
+
+    assert(count == 1U);
+  }
+
+  {
+    _TestSignaling ts1;
+
+    unique_ptr<_TestSignaling> ts2;
+
+    unsigned count = 0U;
+
+    Signaling::ConnectionId ci;
+
+    _TestSignaling::connect<_TestSignaling::SIGNAL_PASS_VOID>(
+        &ts1,
+        [&ts1, &ts2, &ci] (void) {
+          if (ts2 == nullptr)
+            ts2.reset(new _TestSignaling(ts1));
+
+          ts1.disconnect(ci);
+        });
+
+    ci = _TestSignaling::connect<_TestSignaling::SIGNAL_PASS_VOID>(
+        &ts1,
+        [&count] (void) {
+          ++count;
+        });
+
+    ts1.notify<_TestSignaling::SIGNAL_PASS_VOID>();
+
+    assert(count == 0U);
+
+    ts2->notify<_TestSignaling::SIGNAL_PASS_VOID>();
+
+    assert(count == 1U);
+  }
+
+  {
+    _TestSignaling ts;
+
+    _queuedThreadId = this_thread::get_id();
+
+    unsigned n = rand(_RAND_MAX) + 1;
+
+    {
+      ThreadPool threadPool(_N_THREADS, 64UL);
+
+      Signaling::ConnectionId ci =
+        _TestSignaling::connect<_TestSignaling::SIGNAL_PASS_NON_VOID_FIXED>(
+            &ts,
+            threadPool,
+            &_handleQueuedPassNonVoidFixed,
+            data,
+            &_detachQueuedData);
+
+      for (unsigned i = 0U; i < n; ++i)
+        ts.notify<_TestSignaling::SIGNAL_PASS_NON_VOID_FIXED>(_PASS_NON_VOID_FIXED__ARGUMENTS);
+
+      ts.disconnect(ci);
+    }
+
+    assert(_nQueuedPassingNonVoidFixed == n);
+
+    assert(_nQueuedDetachingData == 1U);
+  }
+
+  {
+    _TestExtendedSignaling tes;
+
+    unsigned nExtendedPassings = 0U;
+
+    unsigned nDisconnectedPassings = 0U;
+
+    unsigned nPassingVoid = 0U;
+
+    Signaling::ConnectionId ci;
+
+    _TestSignaling::connect<_TestSignaling::SIGNAL_PASS_VOID>(
+        static_cast<_TestSignaling *>(&tes),
+        [&] (void) {
+          _TestExtendedSignaling::connect<_TestExtendedSignaling::SIGNAL_EXTENDED>(
+              &tes,
+              [&nExtendedPassings] (void) {
+                ++nExtendedPassings;
+              });
+
+          tes.disconnect(ci);
+        });
+
+    ci = _TestSignaling::connect<_TestSignaling::SIGNAL_PASS_VOID>(
+        static_cast<_TestSignaling *>(&tes),
+        [&nDisconnectedPassings] (void) {
+          ++nDisconnectedPassings;
+        });
+
+    _TestSignaling::connect<_TestSignaling::SIGNAL_PASS_VOID>(
+        static_cast<_TestSignaling *>(&tes),
+        [&nPassingVoid] (void) {
+          ++nPassingVoid;
+        });
+
+    tes.notify<_TestSignaling::SIGNAL_PASS_VOID>();
+
+    assert(nDisconnectedPassings == 0U);
+
+    assert(nPassingVoid == 1U);
+
+    tes.notifyExtended();
+
+    assert(nExtendedPassings == 1U);
+  }
+
+  {
+    _TestSignaling ts1;
+
+    _TestSignaling ts2;
+
+    AutoPtr<_TestTrackedReceiver> ttr1 = NEW<_TestTrackedReceiver>();
+
+    AutoPtr<_TestTrackedReceiver> ttr2 = NEW<_TestTrackedReceiver>();
+
+    Signaling::ConnectionId ci = _TestSignaling::connect<_TestSignaling::SIGNAL_PASS_VOID>(
+        &ts1,
+        &_TestTrackedReceiver::onPassVoid,
+        WeakPtr<_TestTrackedReceiver>(ttr1));
+
+    _TestSignaling::connect<_TestSignaling::SIGNAL_PASS_VOID>(
+        &ts1,
+        [&ts2] (void) {
+          ts2.notify<_TestSignaling::SIGNAL_PASS_VOID>();
+        });
+
+    _TestSignaling::connect<_TestSignaling::SIGNAL_PASS_VOID>(
+        &ts2,
+        &_TestTrackedReceiver::onPassVoid,
+        WeakPtr<_TestTrackedReceiver>(ttr2));
+
+    ttr1 = nullptr;
+
+    unsigned nPassingVoid = _TestTrackedReceiver::nPassingVoid;
+
+    ts1.notify<_TestSignaling::SIGNAL_PASS_VOID>();
+
+    assert(_TestTrackedReceiver::nPassingVoid == nPassingVoid + 1U);
+
+    Signaling::ConnectionId ci2 = _TestSignaling::connect<_TestSignaling::SIGNAL_PASS_VOID>(
+        &ts1,
+        [] (void) {});
+
+    assert(ci2.subconnectionId == ci.subconnectionId);
+  }
+
+  {
+    _TestWideSignaling tws;
+
+    unsigned nWidePassings = 0U;
+
+    _TestWideSignaling::connect<_TestWideSignaling::SIGNAL_WIDE>(
+        &tws,
+        [&nWidePassings] (_TestWideSignaling &tws) {
+          ++nWidePassings;
+        });
+
+    tws.notify();
+
+    assert(nWidePassings == 1U);
+  }
+
   delete data;
 
   return 0;
@@ -0,0 +1,129 @@
+/*
+ *
+ * Author: Kevin XU <kevin.xu.1982.02.06@gmail.com>
+ *
+ */
+
+#include <cassert>
+#include <cstdlib>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../include/small-vector.hpp"
+
+#include "rand.hpp"
+
+
+#define _RAND_MAX 1024
+
+
+
+using namespace std;
+
+using namespace Test;
+
+template <class T, size_t N>
+static bool _equal(SmallVector<T, N> const &smallVector, vector<T> const &vector_) noexcept
+{
+  if (smallVector.size() != vector_.size())
+    return false;
+
+  for (size_t i = 0UL; i < vector_.size(); ++i)
+    if (smallVector[i] != vector_[i])
+      return false;
+
+  return true;
+}
+
+int main(int argc, char const *argv[])
+{
+  {
+    SmallVector<string, 2UL> smallVector;
+
+    assert(smallVector.empty());
+
+    assert(smallVector.inlined());
+
+    smallVector.emplace_back("a");
+
+    smallVector.emplace_back(1UL, 'b');
+
+    assert(smallVector.inlined());
+
+    assert(smallVector.capacity() == 2UL);
+
+    smallVector.emplace_back("c");
+
+    assert(!smallVector.inlined());
+
+    assert(_equal(smallVector, vector<string>{"a", "b", "c"}));
+
+    smallVector.erase(smallVector.begin());
+
+    smallVector.pop_back();
+
+    assert(_equal(smallVector, vector<string>{"b"}));
+  }
+
+  {
+    SmallVector<string, 2UL> smallVector;
+
+    vector<string> vector_;
+
+    int n = rand(_RAND_MAX) + 1;
+
+    for (int i = 0; i < n; ++i) {
+      string value = to_string(i);
+
+      size_t index = rand(static_cast<int>(vector_.size()) + 1);
+
+      if (vector_.empty() || rand(3) != 0) {
+        smallVector.emplace(smallVector.begin() + index, value);
+
+        vector_.emplace(vector_.begin() + index, value);
+      } else if (index < vector_.size()) {
+        smallVector.erase(smallVector.begin() + index);
+
+        vector_.erase(vector_.begin() + index);
+      }
+
+      assert(_equal(smallVector, vector_));
+    }
+
+    SmallVector<string, 2UL> copy(smallVector);
+
+    assert(_equal(copy, vector_));
+
+    SmallVector<string, 2UL> other;
+
+    other.emplace_back("x");
+
+    other.swap(copy);
+
+    assert(_equal(other, vector_));
+
+    assert(_equal(copy, vector<string>{"x"}));
+
+    copy = other;
+
+    assert(_equal(copy, vector_));
+
+    SmallVector<string, 2UL> moved(std::move(copy));
+
+    assert(_equal(moved, vector_));
+
+    assert(copy.empty() && copy.inlined());
+
+    moved = std::move(other);
+
+    assert(_equal(moved, vector_));
+
+    moved.clear();
+
+    assert(moved.empty());
+  }
+
+  return 0;
+}
@@ -0,0 +1,297 @@
+/*
+ *
+ * Author: Kevin XU <kevin.xu.1982.02.06@gmail.com>
+ *
+ */
+
+#include <cassert>
+#include <cstdlib>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../include/bounded-queue.hpp"
+#include "../include/inline-function.hpp"
+#include "../include/signaling.hpp"
+#include "../include/thread-pool.hpp"
+
+#include "rand.hpp"
+
+
+#define _RAND_MAX 1024
+
+#define _N_THREADS 4
+
+
+
+using namespace std;
+
+using namespace Test;
+
+class _Throwing {
+public:
+  int value;
+
+  _Throwing(void) noexcept: value(0) {}
+
+  _Throwing(int value): value(value)
+  {
+    if (value < 0)
+      throw runtime_error("");
+  }
+};
+
+static atomic<int> _nCoalescedLives(0);
+
+class _TestCoalescedSignaling: public Signaling, public AtomicRefCounting {
+public:
+  enum {
+    SIGNAL_PASS_INT
+  };
+
+  _TestCoalescedSignaling(void) noexcept
+  {
+    ++_nCoalescedLives;
+  }
+
+  void notify(int value) noexcept
+  {
+    emit<SIGNAL_PASS_INT>(this, value);
+  }
+
+protected:
+  ~_TestCoalescedSignaling()
+  {
+    --_nCoalescedLives;
+  }
+};
+
+template <>
+struct Signaling::SIGNALIZE<_TestCoalescedSignaling, _TestCoalescedSignaling::SIGNAL_PASS_INT> {
+  typedef Signaling::SIGNATURE<int> SIGNATURE;
+};
+
+static atomic<int> _coalescedValue(-1);
+
+static void _handleCoalescedPassInt(_TestCoalescedSignaling &tcs, int value, void *data) noexcept
+{
+  assert(_nCoalescedLives == 1);
+
+  assert(value > _coalescedValue);
+
+  _coalescedValue = value;
+}
+
+static void _push(BoundedQueue<int> *queue, int begin, int end) noexcept
+{
+  for (int i = begin; i < end; ++i)
+    while (!queue->tryPush(i))
+      this_thread::yield();
+}
+
+static void _post(Executor *executor, atomic<int> *sum, int n)
+{
+  for (int i = 0; i < n; ++i)
+    executor->post([sum, i] () {
+      *sum += i;
+    });
+}
+
+int main(int argc, char const *argv[])
+{
+  {
+    BoundedQueue<string> queue(4UL);
+
+    assert(queue.capacity() == 4UL);
+
+    string value;
+
+    assert(!queue.tryPop(value));
+
+    for (int i = 0; i < 4; ++i)
+      assert(queue.tryPush(to_string(i)));
+
+    assert(!queue.tryPush(string("x")));
+
+    for (int i = 0; i < 4; ++i) {
+      assert(queue.tryPop(value));
+
+      assert(value == to_string(i));
+    }
+
+    assert(!queue.tryPop(value));
+
+    assert(queue.tryPush(string("y")));
+  }
+
+  {
+    bool thrown = false;
+
+    try {
+      BoundedQueue<int> queue(3UL);
+    } catch (...) {
+      thrown = true;
+    }
+
+    assert(thrown);
+  }
+
+  {
+    BoundedQueue<_Throwing> queue(2UL);
+
+    bool thrown = false;
+
+    try {
+      queue.tryPush(-1);
+    } catch (...) {
+      thrown = true;
+    }
+
+    assert(thrown);
+
+    assert(queue.tryPush(1));
+
+    _Throwing value;
+
+    assert(queue.tryPop(value));
+
+    assert(value.value == 1);
+
+    assert(!queue.tryPop(value));
+  }
+
+  {
+    BoundedQueue<int> queue(64UL);
+
+    int n = rand(_RAND_MAX) + 1;
+
+    vector<thread> threads;
+
+    for (int i = 0; i < _N_THREADS; ++i)
+      threads.emplace_back(&_push, &queue, i * n, (i + 1) * n);
+
+    vector<int> counts(_N_THREADS * n, 0);
+
+    for (int i = 0, value; i < _N_THREADS * n;)
+      if (queue.tryPop(value)) {
+        ++counts[value];
+
+        ++i;
+      }
+
+    for (auto i = threads.begin(), end = threads.end(); i != end; ++i)
+      i->join();
+
+    for (auto i = counts.begin(), end = counts.end(); i != end; ++i)
+      assert(*i == 1);
+  }
+
+  {
+    int value = 0;
+
+    InlineFunction<void (int)> f([&value] (int v) {
+      value = v;
+    });
+
+    InlineFunction<void (int)> g(f);
+
+    g(25);
+
+    assert(value == 25);
+
+    InlineFunction<void (int)> h(std::move(g));
+
+    assert(!g);
+
+    assert(h);
+
+    string large(100UL, 'x');
+
+    InlineFunction<void (int)> k([&value, large] (int v) {
+      value = v + static_cast<int>(large.size());
+    });
+
+    k.swap(h);
+
+    h(1);
+
+    assert(value == 101);
+
+    k(2);
+
+    assert(value == 2);
+  }
+
+  {
+    atomic<int> sum(0);
+
+    int n = rand(_RAND_MAX) + 1;
+
+    {
+      ThreadPool threadPool(_N_THREADS, 16UL);
+
+      vector<thread> threads;
+
+      for (int i = 0; i < _N_THREADS; ++i)
+        threads.emplace_back(&_post, &threadPool, &sum, n);
+
+      for (auto i = threads.begin(), end = threads.end(); i != end; ++i)
+        i->join();
+    }
+
+    assert(sum == _N_THREADS * (n * (n - 1) / 2));
+  }
+
+  {
+    atomic<bool> done(false);
+
+    Executor::Clock::time_point time = Executor::Clock::now() + chrono::milliseconds(20);
+
+    Executor::Clock::time_point now;
+
+    {
+      ThreadPool threadPool(_N_THREADS);
+
+      threadPool.post([&done, &now] () {
+        now = Executor::Clock::now();
+
+        done = true;
+      }, time);
+
+      while (!done)
+        this_thread::yield();
+    }
+
+    assert(now >= time);
+  }
+
+  {
+    int n = rand(_RAND_MAX) + 1;
+
+    ThreadPool threadPool(_N_THREADS);
+
+    AutoPtr<_TestCoalescedSignaling> tcs = NEW<_TestCoalescedSignaling>();
+
+    _TestCoalescedSignaling::connect<_TestCoalescedSignaling::SIGNAL_PASS_INT>(
+        static_cast<_TestCoalescedSignaling *>(tcs),
+        threadPool,
+        Signaling::Coalescing{chrono::milliseconds(1)},
+        &_handleCoalescedPassInt);
+
+    for (int i = 0; i < n; ++i)
+      tcs->notify(i);
+
+    tcs = nullptr;
+
+    while (_nCoalescedLives != 0)
+      this_thread::yield();
+
+    assert(_coalescedValue == n - 1);
+  }
+
+  return 0;
+}
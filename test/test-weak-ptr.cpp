@@ -0,0 +1,186 @@
+/*
+ *
+ * Author: Kevin XU <kevin.xu.1982.02.06@gmail.com>
+ *
+ */
+
+#include <cassert>
+
+#include <iostream>
+#include <utility>
+
+#include "../include/auto-ptr.hpp"
+#include "../include/ref-counting.hpp"
+#include "../include/weak-ptr.hpp"
+
+
+
+using namespace std;
+
+static void *_destructed = nullptr;
+
+static bool _lockedWhileDestructing = false;
+
+class _TestWeakRefCounting;
+
+static WeakPtr<_TestWeakRefCounting> *_destructing = nullptr;
+
+class _TestWeakRefCounting: public WeakRefCounting {
+public:
+  _TestWeakRefCounting(void) = default;
+
+protected:
+  ~_TestWeakRefCounting() noexcept
+  {
+    if (_destructing != nullptr)
+      _lockedWhileDestructing = _destructing->lock() != nullptr;
+
+    _destructed = this;
+  }
+};
+
+class _TestWeakRefCountingDerived: public _TestWeakRefCounting {
+public:
+  _TestWeakRefCountingDerived(void) = default;
+
+protected:
+  ~_TestWeakRefCountingDerived() = default;
+};
+
+static void _recoverState(void)
+{
+  _destructed = nullptr;
+
+  _lockedWhileDestructing = false;
+
+  delete _destructing;
+
+  _destructing = nullptr;
+}
+
+int main(int argc, char const *argv[])
+{
+  {
+    WeakPtr<_TestWeakRefCounting> twrc;
+
+    assert(twrc.expired());
+
+    assert(twrc.lock() == nullptr);
+
+    twrc = nullptr;
+
+    assert(twrc.expired());
+  }
+
+  {
+    WeakPtr<_TestWeakRefCounting> twrc;
+
+    {
+      AutoPtr<_TestWeakRefCounting> _twrc = NEW<_TestWeakRefCounting>();
+
+      twrc = _twrc;
+
+      assert(!twrc.expired());
+
+      AutoPtr<_TestWeakRefCounting> __twrc = twrc.lock();
+
+      assert(__twrc == _twrc);
+
+      _twrc = nullptr;
+
+      assert(!_destructed);
+
+      assert(!twrc.expired());
+
+      assert(twrc.lock() == __twrc);
+    }
+
+    assert(_destructed);
+
+    assert(twrc.expired());
+
+    assert(twrc.lock() == nullptr);
+
+    _recoverState();
+  }
+
+  {
+    AutoPtr<_TestWeakRefCounting> twrc = NEW<_TestWeakRefCounting>();
+
+    WeakPtr<_TestWeakRefCounting> _twrc = twrc;
+
+    WeakPtr<_TestWeakRefCounting> __twrc = _twrc;
+
+    WeakPtr<_TestWeakRefCounting> ___twrc = move(__twrc);
+
+    assert(__twrc.expired());
+
+    assert(_twrc.lock() == twrc);
+
+    assert(___twrc.lock() == twrc);
+
+    __twrc.swap(___twrc);
+
+    assert(___twrc.expired());
+
+    assert(__twrc.lock() == twrc);
+
+    twrc = nullptr;
+
+    assert(_destructed);
+
+    assert(_twrc.expired());
+
+    assert(__twrc.expired());
+
+    _recoverState();
+  }
+
+  {
+    AutoPtr<_TestWeakRefCountingDerived> twrcd = NEW<_TestWeakRefCountingDerived>();
+
+    WeakPtr<_TestWeakRefCountingDerived> _twrcd = twrcd;
+
+    WeakPtr<_TestWeakRefCounting> twrc = twrcd;
+
+    WeakPtr<_TestWeakRefCounting> _twrc = _twrcd;
+
+    assert(twrc.lock() == twrcd);
+
+    assert(_twrc.lock() == twrcd);
+
+    twrc = move(_twrcd);
+
+    assert(_twrcd.expired());
+
+    assert(twrc.lock() == twrcd);
+
+    twrcd = nullptr;
+
+    assert(_destructed);
+
+    assert(twrc.expired());
+
+    assert(_twrc.expired());
+
+    _recoverState();
+  }
+
+  {
+    AutoPtr<_TestWeakRefCounting> twrc = NEW<_TestWeakRefCounting>();
+
+    _destructing = new WeakPtr<_TestWeakRefCounting>(twrc);
+
+    twrc = nullptr;
+
+    assert(_destructed);
+
+    assert(!_lockedWhileDestructing);
+
+    _recoverState();
+  }
+
+  cout << "\"test-weak-ptr\" passed." << endl;
+
+  return 0;
+}